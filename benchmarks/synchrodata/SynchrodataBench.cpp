@@ -0,0 +1,537 @@
+#include <benchmark/benchmark.h>
+
+#include "synchro/Broadcaster.hpp"
+#include "synchro/DynamicSynchronizedData.hpp"
+#include "synchro/FastBroadcaster.hpp"
+#include "synchro/IsolatedSynchronizedData.hpp"
+#include "synchro/ObjectPool.hpp"
+#include "synchro/Pipeline.hpp"
+#include "synchro/Reactor.hpp"
+#include "synchro/Recorder.hpp"
+#include "synchro/SynchronizedData.hpp"
+#include "synchro/Synchronizer.hpp"
+#include "synchro/ThreadPool.hpp"
+#include "synchro/Trace.hpp"
+#include "synchro/ZipSynchronizedData.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace synchro;
+
+namespace
+{
+template<size_t I>
+struct Tag
+{
+    size_t value = I;
+};
+
+/// @brief Trait class to define a tuple wrapper of N tags starting at Offset
+template<class Seq, size_t Offset>
+struct Tags;
+template<size_t... Is, size_t Offset>
+struct Tags<std::index_sequence<Is...>, Offset>
+{
+    using type = TupleWrapper<Tag<Offset + Is>...>;
+};
+template<size_t N, size_t Offset = 0>
+using TagsOf = typename Tags<std::make_index_sequence<N>, Offset>::type;
+
+/// @brief Preallocated elements of each type of a tuple wrapper, so that allocation is not measured
+template<class W>
+struct Elements;
+template<class... Ts>
+struct Elements<TupleWrapper<Ts...>>
+{
+    std::tuple<std::shared_ptr<Ts>...> elements{std::make_shared<Ts>()...};
+
+    template<class Data>
+    void send(Data& data) const
+    {
+        std::apply([&data](const auto&... element) { (..., data.send(element)); }, elements);
+    }
+
+    template<class Data>
+    void subscribe(Data& data) const
+    {
+        (..., data.template onReceived<Ts>([](const std::shared_ptr<Ts>& element) { benchmark::DoNotOptimize(element.get()); }));
+    }
+};
+
+template<class B>
+void BM_BroadcasterSend(benchmark::State& state)
+{
+    B broadcaster;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        broadcaster.onReceived([](const std::shared_ptr<int>& data) { benchmark::DoNotOptimize(data.get()); });
+    }
+    const auto data = std::make_shared<int>(0);
+    for (auto _ : state)
+    {
+        broadcaster.send(data);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_BroadcasterSend, Broadcaster<int>)->Arg(0)->Arg(1)->Arg(8);
+BENCHMARK_TEMPLATE(BM_BroadcasterSend, FastBroadcaster<int>)->Arg(0)->Arg(1)->Arg(8);
+
+/// @brief Send path with a fast inline subscriber and a slow one posted (0), behind a blocking (1) or conflating (2) mailbox
+void BM_SlowSubscriber(benchmark::State& state)
+{
+    ThreadPool pool(1);
+    FastBroadcaster<int> broadcaster;
+    auto slow = [](const std::shared_ptr<int>& data)
+    {
+        for (int i = 0; i < 64; ++i)
+        {
+            benchmark::DoNotOptimize(*data + i);
+        }
+    };
+    if (state.range(0) == 0)
+    {
+        broadcaster.onReceived(slow, pool.executor());
+    }
+    else
+    {
+        broadcaster.onReceived(slow, pool.executor(), state.range(0) == 1 ? MailboxMode::Block : MailboxMode::Conflate);
+    }
+    int64_t fast = 0;
+    broadcaster.onReceived([&fast](const std::shared_ptr<int>&) { ++fast; });
+    const auto data = std::make_shared<int>(0);
+    for (auto _ : state)
+    {
+        broadcaster.send(data);
+    }
+    state.SetItemsProcessed(fast);
+}
+BENCHMARK(BM_SlowSubscriber)->Arg(0)->Arg(1)->Arg(2);
+
+/// @brief Send path including element allocation, with make_shared (0) or an ObjectPool (1)
+void BM_AllocateSend(benchmark::State& state)
+{
+    FastBroadcaster<Tag<0>> broadcaster;
+    broadcaster.onReceived([](const std::shared_ptr<Tag<0>>& data) { benchmark::DoNotOptimize(data.get()); });
+    ObjectPool<Tag<0>> pool(64);
+    const bool pooled = state.range(0) != 0;
+    for (auto _ : state)
+    {
+        broadcaster.send(pooled ? pool.make() : std::make_shared<Tag<0>>());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["misses"] = static_cast<double>(pool.stats().misses);
+}
+BENCHMARK(BM_AllocateSend)->Arg(0)->Arg(1);
+
+template<size_t NR, size_t NO, size_t NL, class Policy = DefaultPolicy>
+void BM_SynchronizedDataSend(benchmark::State& state)
+{
+    using R = TagsOf<NR>;
+    using O = TagsOf<NO, NR>;
+    using L = TagsOf<NL, NR + NO>;
+    SynchronizedData<R, O, L, Policy> data;
+    const Elements<R> required;
+    const Elements<O> optional;
+    const Elements<L> listed;
+    required.subscribe(data);
+    optional.subscribe(data);
+    listed.subscribe(data);
+
+    for (auto _ : state)
+    {
+        listed.send(data);
+        optional.send(data);
+        required.send(data);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (NR + NO + NL)));
+}
+BENCHMARK_TEMPLATE(BM_SynchronizedDataSend, 1, 0, 0);
+BENCHMARK_TEMPLATE(BM_SynchronizedDataSend, 4, 0, 0);
+BENCHMARK_TEMPLATE(BM_SynchronizedDataSend, 16, 0, 0);
+BENCHMARK_TEMPLATE(BM_SynchronizedDataSend, 4, 4, 0);
+BENCHMARK_TEMPLATE(BM_SynchronizedDataSend, 4, 4, 4);
+BENCHMARK_TEMPLATE(BM_SynchronizedDataSend, 16, 16, 16);
+BENCHMARK_TEMPLATE(BM_SynchronizedDataSend, 4, 4, 4, FastPolicy);
+BENCHMARK_TEMPLATE(BM_SynchronizedDataSend, 16, 16, 16, FastPolicy);
+
+/// @brief Same as BM_SynchronizedDataSend with streams registered at runtime
+template<class Policy = DefaultPolicy>
+void BM_DynamicDataSend(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    DynamicSynchronizedData<Policy> data;
+    std::vector<std::pair<size_t, std::shared_ptr<void>>> elements; // listed, optional then required
+    for (Role role : {Role::List, Role::Optional, Role::Required})
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto id = data.addStream(role);
+            data.onReceived(id, [](const std::shared_ptr<void>& element) { benchmark::DoNotOptimize(element.get()); });
+            elements.emplace_back(id, std::make_shared<Tag<0>>());
+        }
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& [id, element] : elements)
+        {
+            data.send(id, element);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * elements.size()));
+}
+BENCHMARK_TEMPLATE(BM_DynamicDataSend)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_DynamicDataSend, FastPolicy)->Arg(4)->Arg(16);
+
+/// @brief Required elements sent while the last required type is missing, so that each send checks readiness
+template<size_t NR>
+void BM_PendingRequired(benchmark::State& state)
+{
+    using R = TagsOf<NR>;
+    SynchronizedData<R> data;
+    const Elements<TagsOf<NR - 1>> required;
+
+    for (auto _ : state)
+    {
+        required.send(data);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (NR - 1)));
+}
+BENCHMARK_TEMPLATE(BM_PendingRequired, 4);
+BENCHMARK_TEMPLATE(BM_PendingRequired, 16);
+BENCHMARK_TEMPLATE(BM_PendingRequired, 64);
+
+/// @brief Partial sets discarded by their deadline, so that each iteration clears pending required elements
+template<size_t NR>
+void BM_DiscardedRequired(benchmark::State& state)
+{
+    using R = TagsOf<NR>;
+    SynchronizedData<R> data;
+    const Elements<TagsOf<NR - 1>> required;
+    TimerWheel wheel;
+    data.setDeadline(wheel, wheel.tick(), DeadlineAction::Discard);
+    auto now = TimerWheel::Clock::now() + std::chrono::seconds(1); // ahead of the clock, so that expiry is 2 ticks after now
+    wheel.advance(now);
+
+    for (auto _ : state)
+    {
+        required.send(data);
+        now += 3 * wheel.tick();
+        wheel.advance(now);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (NR - 1)));
+}
+BENCHMARK_TEMPLATE(BM_DiscardedRequired, 4);
+BENCHMARK_TEMPLATE(BM_DiscardedRequired, 16);
+BENCHMARK_TEMPLATE(BM_DiscardedRequired, 64);
+
+/// @brief Readers polling the latest set while the first thread sends sets
+void BM_LatestPoll(benchmark::State& state)
+{
+    using R = TagsOf<4>;
+    static SynchronizedData<R, Optional<>, List<>, LatestPolicy> data;
+    const Elements<R> required;
+
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            required.send(data);
+        }
+        else
+        {
+            if (auto snapshot = data.latest())
+            {
+                benchmark::DoNotOptimize(snapshot->get<Tag<0>>().get());
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_LatestPoll)->Threads(2)->Threads(4);
+
+/// @brief Concurrent producers of distinct types while a required type is missing, so that elements stay pending
+template<size_t... Is>
+void BM_IsolatedPending(benchmark::State& state)
+{
+    static IsolatedSynchronizedData<Required<Tag<Is>..., Tag<sizeof...(Is)>>, Optional<>, List<>, FastPolicy> data;
+    const auto index = static_cast<size_t>(state.thread_index()) % sizeof...(Is);
+    const std::tuple<std::shared_ptr<Tag<Is>>...> elements{std::make_shared<Tag<Is>>()...};
+    for (auto _ : state)
+    {
+        (..., (Is == index ? data.send(std::get<Is>(elements)) : void()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_IsolatedPending, 0, 1, 2, 3)->Threads(1)->Threads(2)->Threads(4);
+
+void BM_PendingListFlush(benchmark::State& state)
+{
+    using Data        = SynchronizedData<Required<Tag<0>>, Optional<>, List<Tag<1>>>;
+    const auto count  = static_cast<size_t>(state.range(0));
+    const auto listed = std::make_shared<Tag<1>>();
+    const Elements<Required<Tag<0>>> required;
+    Data data;
+    data.configureList<Tag<1>>(count, OverflowPolicy::DropOldest);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        data.clear(); // back to unsynchronized state
+        data.onReceived<Tag<1>>([](const std::shared_ptr<Tag<1>>& element) { benchmark::DoNotOptimize(element.get()); });
+        for (size_t i = 0; i < count; ++i)
+        {
+            data.send(listed);
+        }
+        state.ResumeTiming();
+        required.send(data); // flushes pending list
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PendingListFlush)->RangeMultiplier(4)->Range(4, 1024);
+
+void BM_ListBatch(benchmark::State& state)
+{
+    using Data        = SynchronizedData<Required<Tag<0>>, Optional<>, List<Tag<1>>>;
+    const auto listed = std::make_shared<Tag<1>>();
+    const Elements<Required<Tag<0>>> required;
+    Data data;
+    if (state.range(0) == 0)
+    {
+        data.onReceived<Tag<1>>([](const std::shared_ptr<Tag<1>>& element) { benchmark::DoNotOptimize(element.get()); });
+    }
+    else
+    {
+        auto batch = [](util::Span<const std::shared_ptr<Tag<1>>> elements)
+        {
+            for (const auto& element : elements)
+            {
+                benchmark::DoNotOptimize(element.get());
+            }
+        };
+        data.onBatch<Tag<1>>(batch, BatchMode::everyCount(static_cast<size_t>(state.range(0))));
+    }
+    required.send(data);
+
+    for (auto _ : state)
+    {
+        data.send(listed);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ListBatch)->Arg(0)->Arg(64);
+
+void BM_TraceRecord(benchmark::State& state)
+{
+    const char* name = typeid(Tag<0>).name();
+    for (auto _ : state)
+    {
+        trace::record(trace::Event::Arrival, name);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TraceRecord)->Threads(1)->Threads(2);
+
+void BM_ZipPairing(benchmark::State& state)
+{
+    // two producers in lockstep, every element paired
+    ZipSynchronizedData<Required<Tag<0>, Tag<1>>> data(static_cast<size_t>(state.range(0)));
+    std::atomic_size_t sets = 0;
+    data.onSynchronized([&sets](const auto&) { sets.fetch_add(1, std::memory_order_relaxed); });
+    const auto first  = std::make_shared<Tag<0>>();
+    const auto second = std::make_shared<Tag<1>>();
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::thread producer(
+            [&data, &second]
+            {
+                for (size_t i = 0; i < 1024; ++i)
+                {
+                    data.send(second);
+                }
+            });
+        state.ResumeTiming();
+        for (size_t i = 0; i < 1024; ++i)
+        {
+            data.send(first);
+        }
+        producer.join();
+    }
+    benchmark::DoNotOptimize(sets.load());
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_ZipPairing)->Arg(1)->Arg(64)->UseRealTime();
+
+void BM_Record(benchmark::State& state)
+{
+    const std::string path = "synchrodata_BENCH_record.log";
+    const auto element     = std::make_shared<Tag<0>>();
+    {
+        Recorder<Required<Tag<0>>> recorder(path);
+        for (auto _ : state)
+        {
+            recorder.record(element);
+        }
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Record);
+
+/// @brief Replay of a recorded log as fast as possible, to be adapted with logs of real traffic
+void BM_Replay(benchmark::State& state)
+{
+    using R = TagsOf<4>;
+    using L = TagsOf<4, 4>;
+    const std::string path = "synchrodata_BENCH_replay.log";
+    const Elements<R> required;
+    const Elements<L> listed;
+    {
+        Recorder<R, Optional<>, L> recorder(path);
+        const auto record = [&recorder](const auto&... element) { (..., recorder.record(element)); };
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            std::apply(record, listed.elements);
+            std::apply(record, required.elements);
+        }
+    }
+    const Replayer<R, Optional<>, L> replayer(path);
+    SynchronizedData<R, Optional<>, L> data;
+    required.subscribe(data);
+    listed.subscribe(data);
+
+    size_t count = 0;
+    for (auto _ : state)
+    {
+        count += replayer.replay(data);
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(static_cast<int64_t>(count));
+}
+BENCHMARK(BM_Replay)->Arg(1024);
+
+template<class T>
+struct Pooler : public Broadcaster<T>
+{
+};
+
+void BM_SynchronizerLatency(benchmark::State& state)
+{
+    Synchronizer<Pooler, Required<Tag<0>, Tag<1>>, Optional<Tag<2>>> synchronizer(std::make_tuple(Pooler<Tag<0>>(), Pooler<Tag<1>>()),
+                                                                                  std::make_tuple(Pooler<Tag<2>>()));
+    size_t received = 0;
+    synchronizer.data().onReceived<Tag<0>>([&received](const std::shared_ptr<Tag<0>>&) { ++received; });
+    const auto r0 = std::make_shared<Tag<0>>();
+    synchronizer.pooler<Tag<1>>().send(std::make_shared<Tag<1>>());
+
+    for (auto _ : state)
+    {
+        synchronizer.pooler<Tag<0>>().send(r0); // from pooler to subscriber
+    }
+    benchmark::DoNotOptimize(received);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SynchronizerLatency);
+
+/// @brief Two stages, chained synchronizers through a pooler (0) or a fused pipeline (1), outputs from an ObjectPool
+void BM_TwoStages(benchmark::State& state)
+{
+    using First  = Stage<Tag<10>, Required<Tag<0>, Tag<1>>>;
+    using Second = Stage<Tag<11>, Required<Tag<10>, Tag<2>>>;
+    ObjectPool<Tag<10>> fused(16);
+    ObjectPool<Tag<11>> detected(16);
+    size_t received = 0;
+    auto first      = [&fused](const First::Set&) { return fused.make(); };
+    auto second     = [&detected, &received](const Second::Set&)
+    {
+        ++received;
+        return detected.make();
+    };
+    const auto r0   = std::make_shared<Tag<0>>();
+
+    if (state.range(0) == 0)
+    {
+        Synchronizer<Pooler, Required<Tag<0>, Tag<1>>> head(std::make_tuple(Pooler<Tag<0>>(), Pooler<Tag<1>>()));
+        Synchronizer<Pooler, Required<Tag<10>, Tag<2>>> tail(std::make_tuple(Pooler<Tag<10>>(), Pooler<Tag<2>>()));
+        auto hop = head.data().onSynchronized([&first, &tail](const First::Set& set) { tail.pooler<Tag<10>>().send(first(set)); });
+        auto end = tail.data().onSynchronized([&second](const Second::Set& set) { second(set); });
+        head.pooler<Tag<1>>().send(std::make_shared<Tag<1>>());
+        tail.pooler<Tag<2>>().send(std::make_shared<Tag<2>>());
+        for (auto _ : state)
+        {
+            head.pooler<Tag<0>>().send(r0);
+        }
+    }
+    else
+    {
+        Pipeline<Pooler, Stages<First, Second>> pipeline(first, second);
+        pipeline.pooler<Tag<1>>().send(std::make_shared<Tag<1>>());
+        pipeline.pooler<Tag<2>>().send(std::make_shared<Tag<2>>());
+        for (auto _ : state)
+        {
+            pipeline.pooler<Tag<0>>().send(r0);
+        }
+    }
+    benchmark::DoNotOptimize(received);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TwoStages)->Arg(0)->Arg(1);
+
+/// @brief One element written to each of N eventfd sources, until all are notified by a single reactor thread
+void BM_ReactorSources(benchmark::State& state)
+{
+    const auto sources          = static_cast<size_t>(state.range(0));
+    std::atomic_size_t received = 0;
+    std::vector<int> fds;
+    {
+        Reactor reactor;
+        std::vector<FdPooler<Tag<0>>> poolers;
+        auto read = [](int fd)
+        {
+            std::uint64_t value = 0;
+            return ::read(fd, &value, sizeof(value)) == sizeof(value) ? std::make_shared<Tag<0>>() : nullptr;
+        };
+        for (size_t i = 0; i < sources; ++i)
+        {
+            fds.push_back(::eventfd(0, EFD_NONBLOCK));
+            poolers.emplace_back(reactor, fds.back(), read);
+            poolers.back().onReceived([&received](const std::shared_ptr<Tag<0>>&) { ++received; });
+        }
+
+        const std::uint64_t one = 1;
+        for (auto _ : state)
+        {
+            received = 0;
+            for (int fd : fds)
+            {
+                benchmark::DoNotOptimize(::write(fd, &one, sizeof(one)));
+            }
+            while (received < sources)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+    for (int fd : fds)
+    {
+        ::close(fd);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * sources));
+}
+BENCHMARK(BM_ReactorSources)->Arg(1)->Arg(64);
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "Policy.hpp"
+#include "SynchronizedData.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+namespace synchro
+{
+/**
+ * @brief Synchronized data matching required elements by timestamp
+ *
+ * Whereas SynchronizedData sends the last received element of each required type, approximate time
+ * data keeps a bounded history of the last @a Depth elements of each required type and sends the
+ * sets of elements (one by required type) whose stamps all fall within a tolerance:
+ * - R : required types (based on @a Required trait). Elements of a type must be sent with
+ * non-decreasing stamps.
+ * - Stamper : timestamp extractor, callable with each required type as const T& and returning a
+ * stamp of the same type for all of them (e.g. a std::chrono::time_point or an integer).
+ * - Depth : history size by type. When full, the oldest element of the type is dropped.
+ * - Policy : same as for SynchronizedData.
+ *
+ * Oldest elements are matched first: when the oldest elements of all types are within tolerance,
+ * they are sent; otherwise the oldest of them cannot be matched anymore and is dropped. Each
+ * element being dropped or sent once, matching costs amortized O(number of types) by element and
+ * no allocation is done by the history.
+ */
+template<class R, class Stamper, std::size_t Depth = 16, class Policy = DefaultPolicy>
+class ApproximateTimeData
+{
+    static_assert(Depth > 0, "history must hold at least one element by type");
+
+public:
+    /// @brief Broadcaster type by element, as defined by the policy
+    template<class T>
+    using Sender = typename Policy::template Broadcaster<T>;
+
+    /// @brief Connection type by element
+    template<class T>
+    using Connection = typename Sender<T>::Connection;
+
+    /// @brief Stamp type returned by the stamper
+    using Stamp = decltype(std::declval<const Stamper&>()(std::declval<const std::tuple_element_t<0, typename R::TupleType>&>()));
+
+    /// @brief Tolerance type, difference between two stamps
+    using Tolerance = decltype(std::declval<Stamp>() - std::declval<Stamp>());
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param tolerance maximal difference between stamps of a matched set
+     * @param stamper timestamp extractor
+     */
+    explicit ApproximateTimeData(Tolerance tolerance, Stamper stamper = Stamper{}) : tolerance_(tolerance), stamper_(std::move(stamper)) {}
+
+    /**
+     * @brief Register callback for type T
+     *
+     * @param cbk callback with prototype void(const std::shared_ptr<T>&) to received notification
+     * @returns broadcaster connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(typename Sender<T>::Callback&& cbk)
+    {
+        static_assert(util::Contains<T, typename R::TupleType>());
+        return std::get<Sender<T>>(broadcasters_).onReceived(std::forward<typename Sender<T>::Callback>(cbk));
+    }
+
+    /**
+     * @brief Send a data element
+     *
+     * does nothing if element is not in the required types
+     *
+     * @param data the element to send
+     */
+    template<class T>
+    void send(const std::shared_ptr<T>& data)
+    {
+        if constexpr (util::Contains<T, typename R::TupleType>())
+        {
+            if (!data)
+            {
+                return;
+            }
+            std::get<History<T>>(histories_).push(data, stamper_(*data));
+            match(std::make_index_sequence<Count>());
+        }
+    }
+
+    /**
+     * @brief Number of elements dropped without being matched for type T
+     * @returns dropped elements count
+     */
+    template<class T>
+    std::size_t dropped() const
+    {
+        return std::get<History<T>>(histories_).dropped;
+    }
+
+    /// @brief Clear all broadcasters and pending data
+    void clear()
+    {
+        std::apply([](auto&... history) { (..., history.clear()); }, histories_);
+        std::apply([](auto&... broadcaster) { (..., broadcaster.clear()); }, broadcasters_);
+    }
+
+private:
+    /// @brief Fixed size ring of the last elements of a type
+    template<class T>
+    struct History
+    {
+        void push(const std::shared_ptr<T>& data, const Stamp& stamp)
+        {
+            if (size == Depth)
+            {
+                pop();
+                ++dropped;
+            }
+            const std::size_t index = (head + size) % Depth;
+            elements[index]         = data;
+            stamps[index]           = stamp;
+            ++size;
+        }
+
+        std::shared_ptr<T> pop()
+        {
+            std::shared_ptr<T> front = std::move(elements[head]);
+            head                     = (head + 1) % Depth;
+            --size;
+            return front;
+        }
+
+        void clear()
+        {
+            while (size > 0)
+            {
+                pop();
+            }
+        }
+
+        std::array<std::shared_ptr<T>, Depth> elements;
+        std::array<Stamp, Depth> stamps{};
+        std::size_t head    = 0;
+        std::size_t size    = 0;
+        std::size_t dropped = 0;
+    };
+
+    /// @brief Histories trait class to define tuple of histories
+    template<class T>
+    struct Histories;
+    /// @brief Specialization to define a tuple of History<T> from tuple of T
+    template<class... Ts>
+    struct Histories<std::tuple<Ts...>>
+    {
+        using type        = std::tuple<History<Ts>...>;
+        using broadcaster = std::tuple<Sender<Ts>...>;
+    };
+
+    static constexpr std::size_t Count = std::tuple_size_v<typename R::TupleType>;
+
+private:
+    template<std::size_t... Is>
+    void match(std::index_sequence<Is...>)
+    {
+        while ((... && (std::get<Is>(histories_).size > 0)))
+        {
+            const std::array<Stamp, Count> fronts = {std::get<Is>(histories_).stamps[std::get<Is>(histories_).head]...};
+            std::size_t oldest                    = 0;
+            std::size_t newest                    = 0;
+            for (std::size_t i = 1; i < Count; ++i)
+            {
+                oldest = fronts[i] < fronts[oldest] ? i : oldest;
+                newest = fronts[newest] < fronts[i] ? i : newest;
+            }
+
+            if (fronts[newest] - fronts[oldest] <= tolerance_)
+            {
+                // pop before sending so that callbacks may send again
+                auto set = std::make_tuple(std::get<Is>(histories_).pop()...);
+                (..., std::get<Is>(broadcasters_).send(std::get<Is>(set)));
+                continue;
+            }
+
+            // oldest front is older than any element of the newest type can match
+            (..., (Is == oldest ? (std::get<Is>(histories_).pop(), ++std::get<Is>(histories_).dropped) : 0));
+        }
+    }
+
+private:
+    Tolerance tolerance_;
+    Stamper stamper_;
+    typename Histories<typename R::TupleType>::type histories_;
+    typename Histories<typename R::TupleType>::broadcaster broadcasters_;
+};
+} // namespace synchro
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Executor.hpp"
+
+#include <boost/asio/post.hpp>
+
+#include <utility>
+
+namespace synchro
+{
+/**
+ * @brief Create an executor posting tasks to a boost::asio executor
+ *
+ * @param executor an asio executor, e.g. io_context::get_executor() or a strand
+ * @returns the executor
+ */
+template<class AsioExecutor>
+Executor makeAsioExecutor(AsioExecutor executor)
+{
+    return Executor([executor](Executor::Task&& task) { boost::asio::post(executor, std::move(task)); });
+}
+} // namespace synchro
@@ -0,0 +1,150 @@
+#pragma once
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+#include "SynchronizedData.hpp"
+#include "Synchronizer.hpp"
+
+#include <boost/signals2.hpp>
+
+#include <coroutine>
+#include <memory>
+#include <mutex>
+
+namespace synchro
+{
+/**
+ * @brief Stream of synchronized sets to await in a coroutine
+ *
+ * Usage, in a coroutine:
+ * @code
+ * SetStream<R, O, L> sets(data, executor);
+ * while (true)
+ * {
+ *     const auto& set = co_await sets.next();
+ *     ...
+ * }
+ * @endcode
+ *
+ * A stream is meant for a single consumer: one coroutine awaits it at a time, and many consumers
+ * use one stream each. Sets completed while the consumer is busy are merged until the next await:
+ * the last required and optional elements are kept, and all listed elements. The awaiting coroutine
+ * is resumed by the executor, inline on the sending thread by default.
+ *
+ * The stream and its executor do not allocate by set once list storage has grown: the awaited set
+ * is double buffered, and resuming only posts the coroutine handle. A coroutine still suspended
+ * when the stream is destroyed is never resumed.
+ *
+ * Only available when compiling as C++20 or later.
+ */
+template<class R, class O = Optional<>, class L = List<>>
+class SetStream
+{
+public:
+    using Set = OwnedSet<R, O, L>; ///< Awaited set type
+
+    /// @brief Awaiter of the next set
+    class Awaiter
+    {
+    public:
+        /// @returns true if a set is already available
+        bool await_ready() const
+        {
+            std::lock_guard<std::mutex> lock(stream_.mutex_);
+            return stream_.ready_;
+        }
+
+        /// @returns false if a set became available, the coroutine is then not suspended
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            std::lock_guard<std::mutex> lock(stream_.mutex_);
+            if (stream_.ready_)
+            {
+                return false;
+            }
+            stream_.waiter_ = handle;
+            return true;
+        }
+
+        /// @returns the set, valid until the next set is awaited
+        const Set& await_resume()
+        {
+            std::lock_guard<std::mutex> lock(stream_.mutex_);
+            std::swap(stream_.current_, stream_.pending_);
+            stream_.ready_ = false;
+            return stream_.current_;
+        }
+
+    private:
+        friend class SetStream;
+        explicit Awaiter(SetStream& stream) : stream_(stream) {}
+
+    private:
+        SetStream& stream_;
+    };
+
+public:
+    /**
+     * @brief Constructor
+     * @param data synchronized data notifying sets
+     * @param executor executor resuming the awaiting coroutine
+     */
+    template<class Policy>
+    explicit SetStream(SynchronizedData<R, O, L, Policy>& data, Executor executor = Executor()) : executor_(std::move(executor))
+    {
+        connection_ = data.onSynchronized([this](const auto& set) { onSet(set); });
+    }
+
+    /**
+     * @brief Constructor
+     * @param synchronizer synchronizer notifying sets
+     * @param executor executor resuming the awaiting coroutine
+     */
+    template<template<class> class Pooler, class Policy>
+    explicit SetStream(Synchronizer<Pooler, R, O, L, Policy>& synchronizer, Executor executor = Executor())
+        : SetStream(synchronizer.data(), std::move(executor))
+    {
+    }
+
+    SetStream(const SetStream&) = delete;
+    SetStream& operator=(const SetStream&) = delete;
+
+    /// @returns awaiter of the next set
+    Awaiter next() { return Awaiter(*this); }
+
+private:
+    template<class S>
+    void onSet(const S& set)
+    {
+        std::coroutine_handle<> waiter;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (ready_)
+            {
+                pending_.merge(set);
+            }
+            else
+            {
+                pending_.assign(set);
+            }
+            ready_ = true;
+            std::swap(waiter, waiter_);
+        }
+        if (waiter)
+        {
+            executor_.post([waiter] { waiter.resume(); });
+        }
+    }
+
+private:
+    Executor executor_;
+    std::mutex mutex_;
+    Set current_;
+    Set pending_;
+    bool ready_ = false;
+    std::coroutine_handle<> waiter_;
+    boost::signals2::scoped_connection connection_;
+};
+} // namespace synchro
+
+#endif
@@ -1,7 +1,12 @@
 #pragma once
 
+#include "Executor.hpp"
+#include "Mailbox.hpp"
+#include "Trace.hpp"
+
 #include <boost/signals2.hpp>
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 
@@ -26,6 +31,33 @@ public:
      */
     Connection onReceived(Callback&& cbk) { return signal_.connect(std::move(cbk)); }
 
+    /**
+     * @brief Register notification callback run by an executor
+     *
+     * Notifications of the callback are run in order, see bindExecutor.
+     *
+     * @param cbk callback for notification
+     * @param executor executor running the callback
+     * @returns Connection of the notification
+     */
+    Connection onReceived(Callback&& cbk, const Executor& executor) { return onReceived(bindExecutor<T>(std::move(cbk), executor)); }
+
+    /**
+     * @brief Register notification callback behind its own mailbox
+     *
+     * Notifications of the callback are run in order, without slowing down the other callbacks, see Mailbox.
+     *
+     * @param cbk callback for notification
+     * @param executor executor running the callback
+     * @param mode behaviour when the callback is slower than sending
+     * @param capacity ring capacity with MailboxMode::Block
+     * @returns Connection of the notification
+     */
+    Connection onReceived(Callback&& cbk, const Executor& executor, MailboxMode mode, std::size_t capacity = Mailbox<T>::DefaultCapacity)
+    {
+        return onReceived(bindMailbox<T>(std::move(cbk), executor, mode, capacity));
+    }
+
     /**
      * @brief Send an element to broadcast
      * @param data element to broadcast to registered callbacks
@@ -36,7 +68,24 @@ public:
     void clear() { signal_.disconnect_all_slots(); }
 
 private:
-    using Signal = boost::signals2::signal<CallbackType>;
+    /// @brief Combiner calling the slots in order, tracing a dispatch around each call
+    struct Dispatch
+    {
+        using result_type = void;
+
+        template<class Iterator>
+        void operator()(Iterator first, Iterator last) const
+        {
+            for (; first != last; ++first)
+            {
+                SYNCHRO_TRACE(DispatchBegin, T);
+                *first;
+                SYNCHRO_TRACE(DispatchEnd, T);
+            }
+        }
+    };
+
+    using Signal = boost::signals2::signal<CallbackType, Dispatch>;
 
 private:
     Signal signal_;
@@ -0,0 +1,272 @@
+#pragma once
+
+#include "SynchronizedData.hpp"
+#include "TimerWheel.hpp"
+#include "util/MpscQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <variant>
+
+namespace synchro
+{
+/**
+ * @brief Synchronized data accepting elements from concurrent producers
+ *
+ * Elements sent from any thread are pushed in a lock-free multi-producer single-consumer queue. A
+ * dispatcher thread owned by the instance drains the queue and runs the synchronization logic of
+ * SynchronizedData, so callbacks are all called from the dispatcher thread. Producers never block
+ * on each other nor on callbacks.
+ *
+ * Requirements for R, O, L and Policy are the same as for SynchronizedData, except that listed types
+ * cannot use OverflowPolicy::Block: elements are all sent from the dispatcher thread, which would
+ * wait forever for itself.
+ */
+template<class R, class O = Optional<>, class L = List<>, class Policy = DefaultPolicy>
+class ConcurrentSynchronizedData
+{
+public:
+    using Data = SynchronizedData<R, O, L, Policy>; ///< Underlying synchronized data type
+
+    /// @brief Connection type by element
+    template<class T>
+    using Connection = typename Data::template Connection<T>;
+
+public:
+    /// @brief Constructor, starts the dispatcher thread
+    ConcurrentSynchronizedData() : dispatcher_([this] { dispatch(); })
+    {
+        static_assert(!blocks(static_cast<typename L::TupleType*>(nullptr)), "OverflowPolicy::Block would deadlock the dispatcher thread");
+    }
+
+    /// @brief Destructor, dispatches already sent elements then stops the dispatcher thread
+    ~ConcurrentSynchronizedData()
+    {
+        stop_ = true;
+        wake();
+        dispatcher_.join();
+        data_.clearDeadline(); // no expiry queued anymore
+    }
+
+    ConcurrentSynchronizedData(const ConcurrentSynchronizedData&) = delete;
+    ConcurrentSynchronizedData& operator=(const ConcurrentSynchronizedData&) = delete;
+
+    /**
+     * @brief Register callback for type T
+     *
+     * @param cbk callback with prototype void(const std::shared_ptr<T>&), called from the dispatcher thread
+     * @returns broadcaster connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(typename Data::template Sender<T>::Callback&& cbk)
+    {
+        return data_.template onReceived<T>(std::forward<typename Data::template Sender<T>::Callback>(cbk));
+    }
+
+    /**
+     * @brief Register callback for type T run by an executor
+     *
+     * @param cbk callback with prototype void(const std::shared_ptr<T>&), posted from the dispatcher thread
+     * @param executor executor running the callback
+     * @returns broadcaster connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(typename Data::template Sender<T>::Callback&& cbk, const Executor& executor)
+    {
+        return data_.template onReceived<T>(std::forward<typename Data::template Sender<T>::Callback>(cbk), executor);
+    }
+
+    /**
+     * @brief Register callback for type T behind its own mailbox, see SynchronizedData::onReceived
+     *
+     * @param cbk callback with prototype void(const std::shared_ptr<T>&), pushed from the dispatcher thread
+     * @param executor executor running the callback
+     * @param mode behaviour when the callback is slower than the dispatcher, MailboxMode::Block blocks the dispatcher thread
+     * @param capacity ring capacity with MailboxMode::Block
+     * @returns broadcaster connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(typename Data::template Sender<T>::Callback&& cbk, const Executor& executor, MailboxMode mode,
+                             std::size_t capacity = Mailbox<T>::DefaultCapacity)
+    {
+        return data_.template onReceived<T>(std::forward<typename Data::template Sender<T>::Callback>(cbk), executor, mode, capacity);
+    }
+
+    /**
+     * @brief Send a data element, may be called concurrently from any thread
+     *
+     * does nothing if element is not in the defined types of the synchronized data
+     *
+     * @param data the element to send
+     */
+    template<class T>
+    void send(const std::shared_ptr<T>& data)
+    {
+        if constexpr (util::Contains<T, AllTypes>())
+        {
+            queue_.push(Element(std::in_place_type<std::shared_ptr<T>>, data));
+            wake();
+        }
+    }
+
+    /**
+     * @brief Change pending list settings of listed type T, must be called before sending elements
+     *
+     * @param capacity maximal number of pending elements
+     * @param overflow behaviour when full, OverflowPolicy::Block is not supported
+     * @throws std::invalid_argument for OverflowPolicy::Block
+     */
+    template<class T>
+    void configureList(std::size_t capacity, OverflowPolicy overflow)
+    {
+        if (overflow == OverflowPolicy::Block)
+        {
+            throw std::invalid_argument("OverflowPolicy::Block is not supported by concurrent synchronized data");
+        }
+        data_.template configureList<T>(capacity, overflow);
+    }
+
+    /**
+     * @brief Number of T elements dropped because the pending list was full
+     * @returns dropped elements count
+     */
+    template<class T>
+    std::size_t dropped() const
+    {
+        return data_.template dropped<T>();
+    }
+
+    /**
+     * @brief Bound the time elements are held before synchronization, must be called before sending elements
+     *
+     * Expiry actions are queued like elements and run by the dispatcher thread, see SynchronizedData::setDeadline.
+     *
+     * @param wheel timer wheel, shared by any number of synchronized data
+     * @param timeout maximal time elements are held
+     * @param action behaviour on expiry
+     */
+    void setDeadline(TimerWheel& wheel, TimerWheel::Clock::duration timeout, DeadlineAction action)
+    {
+        auto post = [this](Executor::Task&& task)
+        {
+            queue_.push(Element(std::in_place_type<TaskCommand>, TaskCommand{std::make_unique<Executor::Task>(std::move(task))}));
+            wake();
+        };
+        data_.setDeadline(wheel, timeout, action, Executor(post));
+    }
+
+    /**
+     * @brief Retrieve metrics, see SynchronizedData::metrics
+     * @returns metrics of the synchronized data
+     */
+    const typename Data::Metrics& metrics() const { return data_.metrics(); }
+
+    /// @returns snapshot of the latest synchronized set, may be called from any thread, see SynchronizedData::latest
+    auto latest() const { return data_.latest(); }
+
+    /// @brief Block until all elements sent before the call are dispatched
+    void flush()
+    {
+        std::promise<void> done;
+        auto future = done.get_future();
+        queue_.push(Element(std::in_place_type<FlushCommand>, FlushCommand{&done}));
+        wake();
+        future.wait();
+    }
+
+    /// @brief Clear all broadcasters, and pending data once elements sent before the call are dispatched
+    void clear()
+    {
+        queue_.push(Element(std::in_place_type<ClearCommand>));
+        wake();
+    }
+
+private:
+    using AllTypes = typename util::Concat<typename R::TupleType, typename O::TupleType, typename L::TupleType>::type;
+
+    struct ClearCommand
+    {
+    };
+    struct FlushCommand
+    {
+        std::promise<void>* done;
+    };
+    struct TaskCommand
+    {
+        std::unique_ptr<Executor::Task> task; // rare, kept out of line so that elements stay small
+    };
+
+    /// @brief Element trait class to define the variant of queued elements
+    template<class T>
+    struct Elements;
+    /// @brief Specialization to define a variant of commands and shared pointers from a tuple
+    template<class... Ts>
+    struct Elements<std::tuple<Ts...>>
+    {
+        using type = std::variant<ClearCommand, FlushCommand, TaskCommand, std::shared_ptr<Ts>...>;
+    };
+    using Element = typename Elements<AllTypes>::type;
+
+    template<class... Ts>
+    static constexpr bool blocks(std::tuple<Ts...>*)
+    {
+        return (... || (ListTraits<Ts>::overflow == OverflowPolicy::Block));
+    }
+
+private:
+    void wake()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst); // pairs with the dispatcher going to sleep
+        if (sleeping_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            wakeup_.notify_one();
+        }
+    }
+
+    void dispatch()
+    {
+        while (true)
+        {
+            if (auto element = queue_.pop())
+            {
+                std::visit([this](auto& value) { process(value); }, *element);
+                continue;
+            }
+            if (stop_)
+            {
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleeping_.store(true, std::memory_order_relaxed); // producers check it after pushing
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            wakeup_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+            sleeping_ = false;
+        }
+    }
+
+    void process(const ClearCommand&) { data_.clear(); }
+    void process(const FlushCommand& command) { command.done->set_value(); }
+    void process(const TaskCommand& command) { (*command.task)(); }
+    template<class T>
+    void process(const std::shared_ptr<T>& data)
+    {
+        data_.send(data);
+    }
+
+private:
+    Data data_;
+    util::MpscQueue<Element> queue_;
+    std::atomic_bool stop_     = false;
+    std::atomic_bool sleeping_ = false;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::thread dispatcher_; // last, started once everything else is constructed
+};
+} // namespace synchro
@@ -0,0 +1,337 @@
+#pragma once
+
+#include "SynchronizedData.hpp"
+
+#include <boost/signals2.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace synchro
+{
+/// @brief Role of a stream of dynamic synchronized data
+enum class Role
+{
+    Required, ///< like a type of Required
+    Optional, ///< like a type of Optional
+    List      ///< like a type of List
+};
+
+/**
+ * @brief Synchronized data configured at runtime
+ *
+ * Same synchronization as SynchronizedData, with streams registered at runtime with a role instead
+ * of types: elements are type-erased shared pointers, and streams are identified by the dense index
+ * returned on registration. Pending elements, presence stamps and broadcasters are flat arrays
+ * indexed by stream, so that sending is a table lookup whatever the configuration, and a single
+ * instantiation serves all configurations. Streams must all be registered before sending.
+ *
+ * Deadlines, metrics and blocking lists are only available with SynchronizedData.
+ */
+template<class Policy = DefaultPolicy>
+class DynamicSynchronizedData
+{
+public:
+    using StreamId   = std::size_t;                                 ///< Dense index of a stream
+    using Sender     = typename Policy::template Broadcaster<void>; ///< Broadcaster type, as defined by the policy
+    using Connection = typename Sender::Connection;                 ///< Connection type by stream
+
+    /// @brief View over a full synchronized set, only valid during the notification
+    class Set
+    {
+    public:
+        /// @returns element of a required or optional stream, null if an optional element was not received
+        const std::shared_ptr<void>& get(StreamId id) const { return data_.streams_[id].role == Role::Required ? data_.held_[id] : data_.pending_[id]; }
+
+        /// @returns element of a required or optional stream, cast to its type
+        template<class T>
+        std::shared_ptr<T> get(StreamId id) const
+        {
+            return std::static_pointer_cast<T>(get(id));
+        }
+
+        /// @returns elements of a listed stream, from oldest to newest
+        util::Span<const std::shared_ptr<void>> list(StreamId id) const
+        {
+            auto elements = data_.lists_[data_.streams_[id].list].linearize();
+            return util::Span<const std::shared_ptr<void>>(elements.data(), elements.size());
+        }
+
+    private:
+        friend class DynamicSynchronizedData;
+        explicit Set(DynamicSynchronizedData& data) : data_(data) {}
+
+    private:
+        DynamicSynchronizedData& data_;
+    };
+
+    using SetCallback   = std::function<void(const Set&)>; ///< Callback for synchronized set notification
+    using SetConnection = boost::signals2::connection;     ///< Synchronized set notification connection
+
+public:
+    DynamicSynchronizedData() = default;
+    DynamicSynchronizedData(const DynamicSynchronizedData&) = delete;
+    DynamicSynchronizedData& operator=(const DynamicSynchronizedData&) = delete;
+
+    /**
+     * @brief Register a stream, must be called before sending elements
+     *
+     * @param role role of the stream
+     * @param capacity maximal number of pending elements of a listed stream
+     * @param overflow behaviour of a listed stream when full, OverflowPolicy::Block is not supported
+     * @returns id of the stream
+     * @throws std::invalid_argument for OverflowPolicy::Block
+     */
+    StreamId addStream(Role role, std::size_t capacity = ListTraits<void>::capacity, OverflowPolicy overflow = ListTraits<void>::overflow)
+    {
+        const StreamId id = streams_.size();
+        Stream stream{role, overflow, 0};
+        if (role == Role::List)
+        {
+            if (overflow == OverflowPolicy::Block)
+            {
+                throw std::invalid_argument("OverflowPolicy::Block is not supported by dynamic synchronized data");
+            }
+            stream.list = lists_.size();
+            lists_.emplace_back(capacity);
+            listIds_.push_back(id);
+        }
+        else
+        {
+            (role == Role::Required ? requiredIds_ : optionalIds_).push_back(id);
+        }
+        missing_ += role == Role::Required ? 1 : 0;
+        streams_.push_back(stream);
+        pending_.emplace_back();
+        held_.emplace_back();
+        stamps_.push_back(0);
+        broadcasters_.emplace_back();
+        dropped_.push_back(0);
+        return id;
+    }
+
+    /**
+     * @brief Register callback for a stream
+     *
+     * @param id stream id
+     * @param cbk callback with prototype void(const std::shared_ptr<void>&)
+     * @returns broadcaster connection to store
+     */
+    Connection onReceived(StreamId id, typename Sender::Callback&& cbk) { return broadcasters_[id].onReceived(std::move(cbk)); }
+
+    /**
+     * @brief Register callback for full synchronized sets
+     *
+     * @param cbk callback with prototype void(const Set&), the set is only valid during the call
+     * @returns connection to store
+     */
+    SetConnection onSynchronized(SetCallback&& cbk)
+    {
+        setSubscribed_ = true;
+        return setSignal_.connect(std::move(cbk));
+    }
+
+    /**
+     * @brief Send an element
+     *
+     * @param id stream id
+     * @param data the element to send
+     */
+    void send(StreamId id, const std::shared_ptr<void>& data)
+    {
+        const Stream& stream = streams_[id];
+        switch (stream.role)
+        {
+        case Role::Required:
+            pending_[id] = data;
+            if (initDone_ || markPresent(id))
+            {
+                if (setSubscribed_)
+                {
+                    sendSynchronized();
+                }
+                broadcasters_[id].send(data);
+                pending_[id].reset();
+                sendPending();
+                initDone_ = true;
+            }
+            break;
+        case Role::Optional:
+            if (initDone_)
+            {
+                broadcasters_[id].send(data);
+                if (!setSubscribed_)
+                {
+                    break;
+                }
+            }
+            pending_[id] = data;
+            break;
+        case Role::List:
+            if (initDone_)
+            {
+                broadcasters_[id].send(data);
+                if (!setSubscribed_)
+                {
+                    break;
+                }
+            }
+            push(id, stream, data);
+            break;
+        }
+    }
+
+    /**
+     * @brief Number of elements of a listed stream dropped because its pending list was full
+     * @returns dropped elements count
+     */
+    std::size_t dropped(StreamId id) const { return dropped_[id]; }
+
+    /// @returns number of registered streams
+    std::size_t size() const { return streams_.size(); }
+
+    /// @brief Clear all broadcasters and pending data, streams are kept
+    void clear()
+    {
+        clearPending();
+        for (auto& broadcaster : broadcasters_)
+        {
+            broadcaster.clear();
+        }
+        setSignal_.disconnect_all_slots();
+        for (auto& held : held_)
+        {
+            held.reset();
+        }
+        setSubscribed_ = false;
+        initDone_      = false;
+    }
+
+private:
+    /// @brief Role of a stream and index of its pending list
+    struct Stream
+    {
+        Role role;
+        OverflowPolicy overflow;
+        std::size_t list;
+    };
+
+private:
+    // returns true if all required streams are present, constant time
+    bool markPresent(StreamId id)
+    {
+        if (stamps_[id] != generation_)
+        {
+            stamps_[id] = generation_;
+            --missing_;
+        }
+        return missing_ == 0;
+    }
+
+    void push(StreamId id, const Stream& stream, const std::shared_ptr<void>& data)
+    {
+        auto& list = lists_[stream.list];
+        if (list.full())
+        {
+            ++dropped_[id];
+            if (stream.overflow == OverflowPolicy::DropNewest || list.empty())
+            {
+                return;
+            }
+            list.pop();
+        }
+        list.push(data);
+    }
+
+    void sendSynchronized()
+    {
+        // hold last required elements, pending ones are the new elements
+        for (StreamId id : requiredIds_)
+        {
+            if (pending_[id])
+            {
+                held_[id] = pending_[id];
+            }
+        }
+        setSignal_(Set(*this));
+        if (initDone_)
+        {
+            // optional and listed elements were already notified one by one
+            clearPending();
+        }
+    }
+
+    // notify pending elements then clear them, by role then registration order
+    void sendPending()
+    {
+        for (StreamId id : requiredIds_)
+        {
+            if (pending_[id])
+            {
+                broadcasters_[id].send(pending_[id]);
+            }
+        }
+        for (StreamId id : optionalIds_)
+        {
+            if (pending_[id])
+            {
+                broadcasters_[id].send(pending_[id]);
+            }
+        }
+        for (StreamId id : listIds_)
+        {
+            auto& list = lists_[streams_[id].list];
+            while (!list.empty()) // pop one by one so that callbacks may send list elements
+            {
+                broadcasters_[id].send(list.pop());
+            }
+        }
+        clearPending();
+    }
+
+    void clearPending()
+    {
+        if (missing_ != requiredIds_.size())
+        {
+            // once synchronized, required elements are never left pending
+            for (StreamId id : requiredIds_)
+            {
+                pending_[id].reset();
+            }
+            ++generation_;
+            missing_ = requiredIds_.size();
+        }
+        for (StreamId id : optionalIds_)
+        {
+            pending_[id].reset();
+        }
+        for (auto& list : lists_)
+        {
+            list.clear();
+        }
+    }
+
+private:
+    bool initDone_      = false;
+    bool setSubscribed_ = false;
+    std::vector<Stream> streams_;
+    std::vector<StreamId> requiredIds_;
+    std::vector<StreamId> optionalIds_;
+    std::vector<StreamId> listIds_;
+
+    std::vector<std::shared_ptr<void>> pending_; // by stream, required and optional elements
+    std::vector<std::shared_ptr<void>> held_;    // by stream, last required elements
+    std::vector<std::uint64_t> stamps_;          // by stream, generation a required element was received in
+    std::uint64_t generation_ = 1;
+    std::size_t missing_      = 0; // required streams without element in the current generation
+    std::vector<util::RingBuffer<std::shared_ptr<void>>> lists_;
+    std::vector<std::size_t> dropped_;
+
+    std::vector<Sender> broadcasters_;
+    boost::signals2::signal<void(const Set&)> setSignal_;
+};
+} // namespace synchro
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "util/MpscQueue.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace synchro
+{
+/**
+ * @brief Handle on an execution context running callbacks
+ *
+ * A default constructed executor runs tasks inline, on the calling thread. Other executors post
+ * tasks to their context (see ThreadPool::executor and makeAsioExecutor); they do not guarantee any
+ * order between tasks.
+ */
+class Executor
+{
+public:
+    using Task = std::function<void()>;       ///< Task to execute
+    using Post = std::function<void(Task&&)>; ///< Function posting a task to the context
+
+public:
+    /// @brief Constructor of the inline executor
+    Executor() = default;
+
+    /**
+     * @brief Constructor
+     * @param post function posting a task to the execution context
+     */
+    explicit Executor(Post post) : post_(std::move(post)) {}
+
+    /**
+     * @brief Execute a task
+     * @param task task to run inline or to post
+     */
+    void post(Task&& task) const
+    {
+        if (post_)
+        {
+            post_(std::move(task));
+            return;
+        }
+        task();
+    }
+
+    /// @returns true if tasks are run inline
+    bool isInline() const { return !post_; }
+
+private:
+    Post post_;
+};
+
+/**
+ * @brief Executor running tasks one at a time, in posting order, on an underlying executor
+ *
+ * Tasks are queued in a lock-free queue; a single drain task is posted to the underlying executor
+ * while tasks are pending.
+ */
+class SerialExecutor : public std::enable_shared_from_this<SerialExecutor>
+{
+public:
+    /**
+     * @brief Create a serial executor
+     * @param executor underlying executor
+     * @returns the serial executor
+     */
+    static std::shared_ptr<SerialExecutor> create(Executor executor) { return std::shared_ptr<SerialExecutor>(new SerialExecutor(std::move(executor))); }
+
+    /**
+     * @brief Post a task, it will run after all previously posted tasks
+     * @param task task to post
+     */
+    void post(Executor::Task&& task)
+    {
+        tasks_.push(std::move(task));
+        if (pending_.fetch_add(1) == 0)
+        {
+            executor_.post([self = shared_from_this()] { self->drain(); });
+        }
+    }
+
+private:
+    explicit SerialExecutor(Executor executor) : executor_(std::move(executor)) {}
+
+    void drain()
+    {
+        do
+        {
+            auto task = tasks_.pop();
+            while (!task)
+            {
+                // counted but not linked yet by the producer
+                std::this_thread::yield();
+                task = tasks_.pop();
+            }
+            (*task)();
+        } while (pending_.fetch_sub(1) > 1);
+    }
+
+private:
+    Executor executor_;
+    util::MpscQueue<Executor::Task> tasks_;
+    std::atomic_size_t pending_ = 0;
+};
+
+/**
+ * @brief Bind a notification callback to an executor
+ *
+ * Notifications are run through a serial executor dedicated to the callback, so that they keep their
+ * order while different callbacks run in parallel. Notifications already posted when the callback is
+ * disconnected are still run.
+ *
+ * @param cbk callback with prototype void(const std::shared_ptr<T>&)
+ * @param executor executor running the callback
+ * @returns callback posting notifications, or cbk itself for an inline executor
+ */
+template<class T>
+std::function<void(const std::shared_ptr<T>&)> bindExecutor(std::function<void(const std::shared_ptr<T>&)>&& cbk, const Executor& executor)
+{
+    if (executor.isInline())
+    {
+        return std::move(cbk);
+    }
+    auto serial   = SerialExecutor::create(executor);
+    auto callback = std::make_shared<std::function<void(const std::shared_ptr<T>&)>>(std::move(cbk));
+    return [serial, callback](const std::shared_ptr<T>& data) { serial->post([callback, data] { (*callback)(data); }); };
+}
+} // namespace synchro
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "Executor.hpp"
+#include "Mailbox.hpp"
+#include "Trace.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace synchro
+{
+/**
+ * @brief Handler for signal notifications with lock-free emission
+ *
+ * Drop-in alternative to Broadcaster. Registered callbacks are kept in an immutable snapshot which is
+ * replaced (copy-on-write) whenever a callback is registered or disconnected. Sending only counts itself
+ * as an active reader and walks the current snapshot: it takes no lock and does no heap allocation.
+ * Replaced snapshots are reclaimed by the next modification observing no active reader, or on destruction.
+ */
+template<class T>
+class FastBroadcaster
+{
+public:
+    using CallbackType = void(const std::shared_ptr<T>&); ///< Callback prototype for notification
+    using Callback     = std::function<CallbackType>;     ///< Callback for notification
+
+private:
+    struct Impl;
+    struct Slot;
+
+public:
+    /// @brief Notification connection
+    class Connection
+    {
+    public:
+        Connection() = default;
+
+        /// @brief Disconnect the callback, it will not be called by subsequent sends
+        void disconnect() const
+        {
+            auto slot = slot_.lock();
+            if (!slot)
+            {
+                return;
+            }
+            slot->connected = false;
+            if (auto impl = impl_.lock())
+            {
+                impl->remove(slot);
+            }
+        }
+
+        /**
+         * @brief Check connection state
+         * @returns true if the callback is still registered
+         */
+        bool connected() const
+        {
+            auto slot = slot_.lock();
+            return slot && slot->connected;
+        }
+
+    private:
+        friend class FastBroadcaster;
+        Connection(std::weak_ptr<Impl> impl, std::weak_ptr<Slot> slot) : impl_(std::move(impl)), slot_(std::move(slot)) {}
+
+    private:
+        std::weak_ptr<Impl> impl_;
+        std::weak_ptr<Slot> slot_;
+    };
+
+public:
+    /**
+     * @brief Register notification callback
+     *
+     * A moved-from broadcaster is usable again once a callback is registered.
+     *
+     * @param cbk callback for notification
+     * @returns Connection of the notification
+     */
+    Connection onReceived(Callback&& cbk)
+    {
+        if (!impl_)
+        {
+            impl_ = std::make_shared<Impl>();
+        }
+        auto slot = std::make_shared<Slot>(std::move(cbk));
+        impl_->add(slot);
+        return Connection(impl_, slot);
+    }
+
+    /**
+     * @brief Register notification callback run by an executor
+     *
+     * Notifications of the callback are run in order, see bindExecutor.
+     *
+     * @param cbk callback for notification
+     * @param executor executor running the callback
+     * @returns Connection of the notification
+     */
+    Connection onReceived(Callback&& cbk, const Executor& executor) { return onReceived(bindExecutor<T>(std::move(cbk), executor)); }
+
+    /**
+     * @brief Register notification callback behind its own mailbox
+     *
+     * Notifications of the callback are run in order, without slowing down the other callbacks, see Mailbox.
+     *
+     * @param cbk callback for notification
+     * @param executor executor running the callback
+     * @param mode behaviour when the callback is slower than sending
+     * @param capacity ring capacity with MailboxMode::Block
+     * @returns Connection of the notification
+     */
+    Connection onReceived(Callback&& cbk, const Executor& executor, MailboxMode mode, std::size_t capacity = Mailbox<T>::DefaultCapacity)
+    {
+        return onReceived(bindMailbox<T>(std::move(cbk), executor, mode, capacity));
+    }
+
+    /**
+     * @brief Send an element to broadcast, does nothing on a moved-from broadcaster
+     * @param data element to broadcast to registered callbacks
+     */
+    void send(const std::shared_ptr<T>& data)
+    {
+        if (!impl_)
+        {
+            return;
+        }
+        impl_->send(data);
+    }
+
+    /// @brief Clear all notifications callbacks
+    void clear()
+    {
+        if (impl_)
+        {
+            impl_->clear();
+        }
+    }
+
+private:
+    struct Slot
+    {
+        explicit Slot(Callback&& cbk) : callback(std::move(cbk)) {}
+
+        Callback callback;
+        std::atomic_bool connected = true;
+    };
+
+    using Slots = std::vector<std::shared_ptr<Slot>>;
+
+    struct Impl
+    {
+        void send(const std::shared_ptr<T>& data)
+        {
+            ReaderGuard guard(readers);
+            const Slots* slots = current.load();
+            if (!slots)
+            {
+                return;
+            }
+            for (const auto& slot : *slots)
+            {
+                if (slot->connected.load(std::memory_order_acquire))
+                {
+                    SYNCHRO_TRACE(DispatchBegin, T);
+                    slot->callback(data);
+                    SYNCHRO_TRACE(DispatchEnd, T);
+                }
+            }
+        }
+
+        void add(const std::shared_ptr<Slot>& slot)
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            auto next = owned ? std::make_unique<Slots>(*owned) : std::make_unique<Slots>();
+            next->push_back(slot);
+            publish(std::move(next));
+        }
+
+        void remove(const std::shared_ptr<Slot>& slot)
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            if (!owned)
+            {
+                return;
+            }
+            auto next = std::make_unique<Slots>();
+            next->reserve(owned->size());
+            for (const auto& registered : *owned)
+            {
+                if (registered != slot)
+                {
+                    next->push_back(registered);
+                }
+            }
+            publish(std::move(next));
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            if (owned)
+            {
+                for (const auto& slot : *owned)
+                {
+                    slot->connected = false;
+                }
+            }
+            publish(nullptr);
+        }
+
+        // must be called with writeMutex held
+        void publish(std::unique_ptr<Slots> next)
+        {
+            current.store(next.get());
+            retired.push_back(std::move(owned));
+            owned = std::move(next);
+            // a reader still counted here may hold any retired snapshot, otherwise none can be reached anymore
+            if (readers.load() == 0)
+            {
+                retired.clear();
+            }
+        }
+
+        std::atomic<const Slots*> current = nullptr;
+        std::atomic_size_t readers         = 0;
+        std::mutex writeMutex;
+        std::unique_ptr<Slots> owned;
+        std::vector<std::unique_ptr<Slots>> retired;
+    };
+
+    /// @brief Scoped registration of an active sender
+    struct ReaderGuard
+    {
+        explicit ReaderGuard(std::atomic_size_t& count) : counter(count) { counter.fetch_add(1); }
+        ~ReaderGuard() { counter.fetch_sub(1); }
+        ReaderGuard(const ReaderGuard&) = delete;
+        ReaderGuard& operator=(const ReaderGuard&) = delete;
+
+        std::atomic_size_t& counter;
+    };
+
+private:
+    std::shared_ptr<Impl> impl_ = std::make_shared<Impl>();
+};
+} // namespace synchro
@@ -0,0 +1,326 @@
+#pragma once
+
+#include "SynchronizedData.hpp"
+#include "util/RingBuffer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace synchro
+{
+/**
+ * @brief Synchronized data for concurrent producers of distinct types
+ *
+ * Same synchronization as SynchronizedData for required, optional and listed types, with send
+ * callable concurrently from any thread. The pending element of each type sits on its own cache lines, with
+ * its own spin lock, so that producers of distinct types do not interfere. Presence of required
+ * types and the synchronized state are a single atomic word: marking a type present tells whether
+ * the set is complete, and once synchronized, sending is a single atomic load before notifying.
+ *
+ * Callbacks are called from the producer threads, by the producer completing the set for pending
+ * elements. Once synchronized, notifications from distinct producers are not ordered with each
+ * other, nor with the notification of the pending elements.
+ *
+ * Listed elements are queued in a bounded ring by type, under the spin lock of the type, until the
+ * set is complete, then all sent in order. Capacity and overflow policy are set by ListTraits;
+ * OverflowPolicy::Block is not supported: a full ring would make its producer spin, without a
+ * condition variable to wait on, until another producer completes the set.
+ *
+ * Requirements for R, O, L and Policy are the same as for SynchronizedData, with at most 63 required
+ * types; the broadcasters of the policy must accept concurrent sends (both provided ones do).
+ */
+template<class R, class O = Optional<>, class L = List<>, class Policy = DefaultPolicy>
+class IsolatedSynchronizedData
+{
+public:
+    /// @brief Broadcaster type by element, as defined by the policy
+    template<class T>
+    using Sender = typename Policy::template Broadcaster<T>;
+
+    /// @brief Connection type by element
+    template<class T>
+    using Connection = typename Sender<T>::Connection;
+
+public:
+    /**
+     * @brief Register callback for type T
+     *
+     * @param cbk callback with prototype void(const std::shared_ptr<T>&), may be called from any producer thread
+     * @returns broadcaster connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(typename Sender<T>::Callback&& cbk)
+    {
+        return sender<T>().onReceived(std::forward<typename Sender<T>::Callback>(cbk));
+    }
+
+    /**
+     * @brief Register callback for type T run by an executor
+     *
+     * @param cbk callback with prototype void(const std::shared_ptr<T>&)
+     * @param executor executor running the callback
+     * @returns broadcaster connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(typename Sender<T>::Callback&& cbk, const Executor& executor)
+    {
+        return sender<T>().onReceived(std::forward<typename Sender<T>::Callback>(cbk), executor);
+    }
+
+    /**
+     * @brief Send a data element, may be called concurrently from any thread
+     *
+     * does nothing if element is not in the defined types of the synchronized data
+     *
+     * @param data the element to send
+     */
+    template<class T>
+    void send(const std::shared_ptr<T>& data)
+    {
+        if constexpr (util::Contains<T, typename L::TupleType>())
+        {
+            auto& list = std::get<ListSlot<T>>(listSlots_);
+            if (state_.load(std::memory_order_acquire) & Synchronized)
+            {
+                list.sender.send(data);
+                return;
+            }
+            list.push(data);
+            if (state_.load(std::memory_order_acquire) & Synchronized)
+            {
+                // synchronized meanwhile, the element may have been missed by the flush
+                sendPending(list);
+            }
+        }
+        else if constexpr (util::Contains<T, typename R::TupleType>() || util::Contains<T, typename O::TupleType>())
+        {
+            auto& pending = slot<T>();
+            if (state_.load(std::memory_order_acquire) & Synchronized)
+            {
+                pending.sender.send(data);
+                return;
+            }
+            auto previous       = pending.exchange(data); // only the last one is kept, released outside the lock
+            std::uint64_t state = state_.load(std::memory_order_acquire);
+            if constexpr (util::Contains<T, typename R::TupleType>())
+            {
+                // the producer completing the set marks it synchronized in the same operation, and flushes it
+                constexpr std::uint64_t bit = std::uint64_t(1) << util::Index<T, typename R::TupleType>::value;
+                std::uint64_t next          = 0;
+                do
+                {
+                    next = state | bit;
+                    next = next == Complete ? next | Synchronized : next;
+                } while (!state_.compare_exchange_weak(state, next, std::memory_order_acq_rel, std::memory_order_acquire));
+                if (!(state & Synchronized) && (next & Synchronized))
+                {
+                    flush();
+                    return;
+                }
+            }
+            if (state & Synchronized)
+            {
+                // synchronized meanwhile, the element may have been missed by the flush
+                if (auto own = pending.exchange(nullptr))
+                {
+                    pending.sender.send(own);
+                }
+            }
+        }
+    }
+
+    /// @returns true once all required types were received, a single atomic load
+    bool synchronized() const { return (state_.load(std::memory_order_acquire) & Synchronized) != 0; }
+
+    /**
+     * @brief Number of T elements dropped because the pending ring was full
+     * @returns dropped elements count
+     */
+    template<class T>
+    std::size_t dropped() const
+    {
+        static_assert(util::Contains<T, typename L::TupleType>());
+        return std::get<ListSlot<T>>(listSlots_).dropped.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Clear all broadcasters and pending data, must not be called concurrently with send
+    void clear()
+    {
+        auto clear = [](auto&... slot) { (..., (slot.exchange(nullptr), slot.sender.clear())); };
+        std::apply(clear, requiredSlots_);
+        std::apply(clear, optionalSlots_);
+        std::apply([](auto&... list) { (..., (list.drain(), list.sender.clear())); }, listSlots_);
+        state_.store(Initial, std::memory_order_release);
+    }
+
+private:
+    static constexpr std::size_t RequiredCount = std::tuple_size_v<typename R::TupleType>;
+    static_assert(RequiredCount < 64, "at most 63 required types");
+    static constexpr std::uint64_t Synchronized = std::uint64_t(1) << 63;
+    static constexpr std::uint64_t Complete     = (std::uint64_t(1) << RequiredCount) - 1;
+    static constexpr std::uint64_t Initial      = RequiredCount == 0 ? Synchronized : 0;
+
+    template<class... Ts>
+    static constexpr bool blocks(std::tuple<Ts...>*)
+    {
+        return (... || (ListTraits<Ts>::overflow == OverflowPolicy::Block));
+    }
+    static_assert(!blocks(static_cast<typename L::TupleType*>(nullptr)), "OverflowPolicy::Block is not supported by isolated synchronized data");
+
+    /// @brief Pending element of a type and its broadcaster, on their own cache lines
+    template<class T>
+    struct alignas(64) Slot
+    {
+        std::shared_ptr<T> exchange(std::shared_ptr<T> data)
+        {
+            while (lock.test_and_set(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            std::swap(pending, data);
+            lock.clear(std::memory_order_release);
+            return data;
+        }
+
+        std::atomic_flag lock = ATOMIC_FLAG_INIT;
+        std::shared_ptr<T> pending;
+        Sender<T> sender;
+    };
+
+    /// @brief Pending elements of a listed type and its broadcaster, on their own cache lines
+    template<class T>
+    struct alignas(64) ListSlot
+    {
+        void push(const std::shared_ptr<T>& data)
+        {
+            std::shared_ptr<T> oldest; // released outside the lock
+            acquire();
+            if (ring.full())
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                if (ListTraits<T>::overflow == OverflowPolicy::DropNewest || ring.empty())
+                {
+                    lock.clear(std::memory_order_release);
+                    return;
+                }
+                oldest = ring.pop();
+            }
+            ring.push(data);
+            lock.clear(std::memory_order_release);
+        }
+
+        // pending elements from oldest to newest, the ring is left empty
+        std::vector<std::shared_ptr<T>> drain()
+        {
+            std::vector<std::shared_ptr<T>> elements;
+            acquire();
+            elements.reserve(ring.size());
+            while (!ring.empty())
+            {
+                elements.push_back(ring.pop());
+            }
+            lock.clear(std::memory_order_release);
+            return elements;
+        }
+
+        void acquire()
+        {
+            while (lock.test_and_set(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        std::atomic_flag lock = ATOMIC_FLAG_INIT;
+        util::RingBuffer<std::shared_ptr<T>> ring{ListTraits<T>::capacity};
+        std::atomic_size_t dropped{0};
+        Sender<T> sender;
+    };
+
+    /// @brief Slots trait class to define tuple of slots
+    template<class T>
+    struct Slots;
+    /// @brief Specialization to define a tuple of Slot<T> from tuple of T
+    template<class... Ts>
+    struct Slots<std::tuple<Ts...>>
+    {
+        using type = std::tuple<Slot<Ts>...>;
+    };
+
+    /// @brief Slots trait class to define tuple of list slots
+    template<class T>
+    struct ListSlots;
+    /// @brief Specialization to define a tuple of ListSlot<T> from tuple of T
+    template<class... Ts>
+    struct ListSlots<std::tuple<Ts...>>
+    {
+        using type = std::tuple<ListSlot<Ts>...>;
+    };
+
+private:
+    template<class T>
+    Sender<T>& sender()
+    {
+        if constexpr (util::Contains<T, typename L::TupleType>())
+        {
+            return std::get<ListSlot<T>>(listSlots_).sender;
+        }
+        else
+        {
+            return slot<T>().sender;
+        }
+    }
+
+    template<class T>
+    Slot<T>& slot()
+    {
+        static_assert(util::Contains<T, typename R::TupleType>() || util::Contains<T, typename O::TupleType>());
+        if constexpr (util::Contains<T, typename R::TupleType>())
+        {
+            return std::get<Slot<T>>(requiredSlots_);
+        }
+        else
+        {
+            return std::get<Slot<T>>(optionalSlots_);
+        }
+    }
+
+    // called by the single producer completing the set
+    void flush()
+    {
+        auto send = [](auto&... slot) { (..., sendPending(slot)); };
+        std::apply(send, requiredSlots_);
+        std::apply(send, optionalSlots_);
+        std::apply(send, listSlots_);
+    }
+
+    template<class T>
+    static void sendPending(Slot<T>& slot)
+    {
+        if (auto data = slot.exchange(nullptr))
+        {
+            slot.sender.send(data);
+        }
+    }
+
+    template<class T>
+    static void sendPending(ListSlot<T>& list)
+    {
+        for (const auto& data : list.drain())
+        {
+            list.sender.send(data);
+        }
+    }
+
+private:
+    typename Slots<typename R::TupleType>::type requiredSlots_;
+    typename Slots<typename O::TupleType>::type optionalSlots_;
+    typename ListSlots<typename L::TupleType>::type listSlots_;
+    alignas(64) std::atomic<std::uint64_t> state_{Initial}; // presence bit by required type, and Synchronized
+};
+} // namespace synchro
@@ -0,0 +1,381 @@
+#pragma once
+
+#include "FastBroadcaster.hpp"
+#include "SynchronizedData.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+namespace synchro
+{
+/**
+ * @brief Independent synchronized data by key
+ *
+ * Each key (e.g. a camera or a client session) has its own SynchronizedData state, created on the
+ * first element sent for the key. Keys are spread over shards, each with its own lock and cache
+ * lines, so that senders of keys in different shards do not contend. Keys not used for a while can
+ * be evicted to bound memory, explicitly or automatically with an idle timeout.
+ *
+ * Each shard indexes its keys with an open addressing table (linear probing) of hashes and entry
+ * indices, so that a lookup probes a flat array and reaches the entry without any node. Entries are
+ * constructed in place in a stable storage, as synchronized data cannot be moved, and entries of
+ * evicted keys are reused by new keys, with a new synchronized data.
+ *
+ * Callbacks are registered once for all keys and called with the key, from the sending thread once
+ * the shard of the key is unlocked: notifications of a send are queued while the shard is locked,
+ * then emitted through FastBroadcaster, whatever the policy, so that senders of different shards
+ * share no lock. Callbacks may send elements to any key.
+ *
+ * Requirements for R, O, L and Policy are the same as for SynchronizedData
+ */
+template<class Key, class R, class O = Optional<>, class L = List<>, class Policy = DefaultPolicy, class Hash = std::hash<Key>>
+class KeyedSynchronizedData
+{
+public:
+    using Data  = SynchronizedData<R, O, L, Policy>; ///< Synchronized data type by key
+    using Clock = std::chrono::steady_clock;          ///< Clock used for idle timeout
+
+    /// @brief Connection type by element
+    template<class T>
+    using Connection = typename FastBroadcaster<T>::Connection;
+
+    /// @brief Callback prototype for notification of type T
+    template<class T>
+    using Callback = std::function<void(const Key&, const std::shared_ptr<T>&)>;
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param shards number of shards, rounded up to a power of two
+     * @param idleTimeout keys not used for this duration are evicted while sending, zero to disable
+     */
+    explicit KeyedSynchronizedData(std::size_t shards = 64, Clock::duration idleTimeout = Clock::duration::zero()) : idleTimeout_(idleTimeout)
+    {
+        std::size_t count = 1;
+        while (count < shards)
+        {
+            count <<= 1;
+            ++shardBits_;
+        }
+        shards_ = std::vector<Shard>(count);
+    }
+    KeyedSynchronizedData(const KeyedSynchronizedData&) = delete;
+    KeyedSynchronizedData& operator=(const KeyedSynchronizedData&) = delete;
+
+    /**
+     * @brief Register callback for type T, for all keys
+     *
+     * @param cbk callback with prototype void(const Key&, const std::shared_ptr<T>&)
+     * @returns connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(Callback<T>&& cbk)
+    {
+        static_assert(util::Contains<T, AllTypes>());
+        return std::get<FastBroadcaster<T>>(broadcasters_).onReceived([cbk = std::move(cbk)](const std::shared_ptr<T>& data) { cbk(*emittingKey_, data); });
+    }
+
+    /**
+     * @brief Send a data element for a key
+     *
+     * does nothing if element is not in the defined types of the synchronized data
+     *
+     * @param key key of the element stream
+     * @param data the element to send
+     */
+    template<class T>
+    void send(const Key& key, const std::shared_ptr<T>& data)
+    {
+        if constexpr (util::Contains<T, AllTypes>())
+        {
+            const std::uint64_t hash = mix(key);
+            auto& shard              = shards_[shardIndex(hash)];
+            const auto now           = Clock::now();
+            const std::size_t first  = outbox_.size(); // a stack: sends from callbacks emit their own notifications
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                if (idleTimeout_ > Clock::duration::zero() && now - shard.lastSweep > idleTimeout_)
+                {
+                    shard.lastSweep = now;
+                    sweep(shard, now - idleTimeout_);
+                }
+
+                auto& entry    = acquire(shard, hash, key);
+                entry.lastUsed = now;
+                entry.data->send(data);
+            }
+            for (std::size_t i = first; i < outbox_.size(); ++i)
+            {
+                const Notification notification = std::move(outbox_[i]); // moved out, callbacks may grow the outbox
+                emit(notification);
+            }
+            outbox_.resize(first);
+        }
+    }
+
+    /**
+     * @brief Evict keys not used for a duration, their pending data are dropped
+     * @param maxIdle duration since the last element of evicted keys
+     * @returns number of evicted keys
+     */
+    std::size_t evictIdle(Clock::duration maxIdle)
+    {
+        const auto limit  = Clock::now() - maxIdle;
+        std::size_t count = 0;
+        for (auto& shard : shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            count += sweep(shard, limit);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Evict a key, its pending data are dropped
+     * @param key key to evict
+     */
+    void evict(const Key& key)
+    {
+        const std::uint64_t hash = mix(key);
+        auto& shard              = shards_[shardIndex(hash)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.slots.empty())
+        {
+            return;
+        }
+        const std::size_t position = probe(shard, hash, key);
+        if (shard.slots[position].entry != Empty)
+        {
+            erase(shard, position);
+        }
+    }
+
+    /// @returns number of keys
+    std::size_t size() const
+    {
+        std::size_t count = 0;
+        for (auto& shard : shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            count += shard.size;
+        }
+        return count;
+    }
+
+    /// @brief Clear all callbacks and keys
+    void clear()
+    {
+        for (auto& shard : shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.slots.clear();
+            shard.entries.clear();
+            shard.free.clear();
+            shard.size = 0;
+            shard.bits = 0;
+        }
+        std::apply([](auto&... broadcaster) { (..., broadcaster.clear()); }, broadcasters_);
+    }
+
+private:
+    using AllTypes = typename util::Concat<typename R::TupleType, typename O::TupleType, typename L::TupleType>::type;
+
+    /// @brief Elements trait class to define tuple of broadcasters and variant of elements
+    template<class T>
+    struct Elements;
+    /// @brief Specialization for tuples
+    template<class... Ts>
+    struct Elements<std::tuple<Ts...>>
+    {
+        using Broadcasters = std::tuple<FastBroadcaster<Ts>...>;
+        using Element      = std::variant<std::shared_ptr<Ts>...>;
+    };
+
+    /// @brief Notification queued while the shard is locked
+    struct Notification
+    {
+        Key key;
+        typename Elements<AllTypes>::Element element;
+    };
+
+    struct Entry
+    {
+        std::optional<Data> data; // constructed for each key, so that no state of an evicted key remains
+        std::optional<Key> key;   // empty once evicted
+        Clock::time_point lastUsed;
+    };
+
+    static constexpr std::size_t Empty = ~std::size_t(0); ///< entry index of an empty slot
+
+    /// @brief Slot of the open addressing table, hash kept to skip other keys and to grow without hashing
+    struct Slot
+    {
+        std::uint64_t hash = 0;
+        std::size_t entry  = Empty;
+    };
+
+    /// @brief Keys of a shard, on their own cache lines
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        std::vector<Slot> slots;       // power of two, at most 3/4 full
+        std::size_t bits = 0;          // log2 of the number of slots
+        std::size_t size = 0;          // number of keys
+        std::deque<Entry> entries;     // never moved, indexed by slots
+        std::vector<std::size_t> free; // entries of evicted keys
+        Clock::time_point lastSweep = Clock::now();
+    };
+
+private:
+    // fibonacci hashing, so that shards and slots do not depend on the low bits of the hash only
+    static std::uint64_t mix(const Key& key) { return static_cast<std::uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull; }
+
+    // shards use the highest bits of the hash, slots the following ones
+    std::size_t shardIndex(std::uint64_t hash) const { return shardBits_ == 0 ? 0 : static_cast<std::size_t>(hash >> (64 - shardBits_)); }
+    std::size_t home(const Shard& shard, std::uint64_t hash) const { return static_cast<std::size_t>((hash << shardBits_) >> (64 - shard.bits)); }
+
+    // returns position of the key, or of the empty slot ending its probe sequence
+    std::size_t probe(const Shard& shard, std::uint64_t hash, const Key& key) const
+    {
+        const std::size_t mask = shard.slots.size() - 1;
+        for (std::size_t i = home(shard, hash);; i = (i + 1) & mask)
+        {
+            const Slot& slot = shard.slots[i];
+            if (slot.entry == Empty || (slot.hash == hash && *shard.entries[slot.entry].key == key))
+            {
+                return i;
+            }
+        }
+    }
+
+    Entry& acquire(Shard& shard, std::uint64_t hash, const Key& key)
+    {
+        if (!shard.slots.empty())
+        {
+            const Slot& slot = shard.slots[probe(shard, hash, key)];
+            if (slot.entry != Empty)
+            {
+                return shard.entries[slot.entry];
+            }
+        }
+        if ((shard.size + 1) * 4 > shard.slots.size() * 3)
+        {
+            grow(shard);
+        }
+
+        std::size_t index = shard.entries.size();
+        if (shard.free.empty())
+        {
+            shard.entries.emplace_back();
+        }
+        else
+        {
+            index = shard.free.back();
+            shard.free.pop_back();
+        }
+        auto& entry = shard.entries[index];
+        entry.key.emplace(key);
+        entry.data.emplace();
+        connect(entry, key, static_cast<AllTypes*>(nullptr));
+        shard.slots[probe(shard, hash, key)] = Slot{hash, index};
+        ++shard.size;
+        return entry;
+    }
+
+    void grow(Shard& shard)
+    {
+        const std::vector<Slot> slots = std::move(shard.slots);
+        shard.bits                    = shard.bits == 0 ? 3 : shard.bits + 1;
+        shard.slots                   = std::vector<Slot>(std::size_t(1) << shard.bits);
+        const std::size_t mask        = shard.slots.size() - 1;
+        for (const auto& slot : slots)
+        {
+            if (slot.entry == Empty)
+            {
+                continue;
+            }
+            std::size_t i = home(shard, slot.hash);
+            while (shard.slots[i].entry != Empty)
+            {
+                i = (i + 1) & mask;
+            }
+            shard.slots[i] = slot;
+        }
+    }
+
+    // backward shift deletion: no tombstone, following keys of the probe sequence are moved back
+    void erase(Shard& shard, std::size_t position)
+    {
+        auto& entry = shard.entries[shard.slots[position].entry];
+        entry.data.reset();
+        entry.key.reset();
+        shard.free.push_back(shard.slots[position].entry);
+        --shard.size;
+
+        const std::size_t mask = shard.slots.size() - 1;
+        std::size_t hole       = position;
+        for (std::size_t i = (position + 1) & mask; shard.slots[i].entry != Empty; i = (i + 1) & mask)
+        {
+            // the key may fill the hole unless the hole is before its home position
+            if (((i - home(shard, shard.slots[i].hash)) & mask) >= ((i - hole) & mask))
+            {
+                shard.slots[hole] = shard.slots[i];
+                hole              = i;
+            }
+        }
+        shard.slots[hole] = Slot{};
+    }
+
+    template<class... Ts>
+    void connect(Entry& entry, const Key& key, std::tuple<Ts...>*)
+    {
+        (..., entry.data->template onReceived<Ts>([key](const std::shared_ptr<Ts>& data) { outbox_.push_back(Notification{key, data}); }));
+    }
+
+    void emit(const Notification& notification)
+    {
+        const Key* previous = emittingKey_; // restored for the callbacks of an outer emission
+        emittingKey_        = &notification.key;
+        std::visit([this](const auto& data) { std::get<FastBroadcaster<typename std::decay_t<decltype(data)>::element_type>>(broadcasters_).send(data); },
+                   notification.element);
+        emittingKey_ = previous;
+    }
+
+    // must be called with shard mutex held
+    std::size_t sweep(Shard& shard, Clock::time_point limit)
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < shard.slots.size();)
+        {
+            const Slot& slot = shard.slots[i];
+            if (slot.entry != Empty && shard.entries[slot.entry].lastUsed < limit)
+            {
+                erase(shard, i); // a following key may be shifted to i, checked again
+                ++count;
+                continue;
+            }
+            ++i;
+        }
+        return count;
+    }
+
+private:
+    Clock::duration idleTimeout_;
+    std::size_t shardBits_ = 0;
+    std::vector<Shard> shards_;
+    typename Elements<AllTypes>::Broadcasters broadcasters_;
+
+    static inline thread_local std::vector<Notification> outbox_; // notifications of the sends of the thread, storage kept
+    static inline thread_local const Key* emittingKey_ = nullptr; // key of the notification being emitted by the thread
+};
+} // namespace synchro
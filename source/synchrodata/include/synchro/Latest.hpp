@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace synchro
+{
+/// @brief Publication of the latest synchronized set, disabled (compiled out)
+template<class Set>
+class NoLatest
+{
+public:
+    static constexpr bool Enabled = false; ///< sets are not published
+
+    /// @brief Does nothing
+    template<class View>
+    void publish(const View&)
+    {
+    }
+};
+
+/**
+ * @brief Publication of the latest synchronized set to polling readers
+ *
+ * The single writer, the thread sending elements to synchronized data, copies each set in one of
+ * Slots buffers then publishes its index. Readers pin the published buffer with a counter by buffer
+ * and read it in place: polling neither copies the set nor takes references on its elements, and
+ * never blocks the writer. A buffer is only rewritten once no reader pins it; if all buffers except
+ * the published one are pinned, the set is not published and readers keep the previous one.
+ *
+ * Set is an owning set type such as OwnedSet, with assign(view) from a SynchronizedSet.
+ */
+template<class Set, std::size_t Slots = 4>
+class LatestSet
+{
+    static_assert(Slots >= 2, "at least one buffer besides the published one");
+
+    /// @brief Buffer and its readers, on their own cache lines
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint32_t> readers{0};
+        Set set;
+    };
+
+public:
+    static constexpr bool Enabled = true; ///< sets are published
+
+    /// @brief Pinned set, valid while the snapshot lives
+    class Snapshot
+    {
+    public:
+        /// @brief Constructor of an empty snapshot
+        Snapshot() = default;
+        /// @brief Destructor, unpins the set
+        ~Snapshot() { release(); }
+
+        Snapshot(Snapshot&& other) noexcept : slot_(std::exchange(other.slot_, nullptr)) {}
+        Snapshot& operator=(Snapshot&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                slot_ = std::exchange(other.slot_, nullptr);
+            }
+            return *this;
+        }
+
+        /// @returns true if a set was published
+        explicit operator bool() const { return slot_ != nullptr; }
+        /// @returns pinned set, the snapshot must not be empty
+        const Set& operator*() const { return slot_->set; }
+        /// @returns pinned set, the snapshot must not be empty
+        const Set* operator->() const { return &slot_->set; }
+
+    private:
+        friend class LatestSet;
+        explicit Snapshot(Slot* slot) : slot_(slot) {}
+
+        void release()
+        {
+            if (slot_)
+            {
+                slot_->readers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+    private:
+        Slot* slot_ = nullptr;
+    };
+
+public:
+    /**
+     * @brief Publish a set, must only be called by the writer
+     * @param view set to copy
+     * @returns false if all buffers are pinned and the set was not published
+     */
+    template<class View>
+    bool publish(const View& view)
+    {
+        const std::size_t current = published_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < Slots; ++i)
+        {
+            // sequentially consistent with the pinning of readers: a buffer seen unpinned here cannot be
+            // pinned by a reader validating it before it is published again
+            if (i != current && slots_[i].readers.load() == 0)
+            {
+                slots_[i].set.assign(view);
+                published_.store(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Pin the latest set, may be called from any thread
+     * @returns snapshot of the latest set, empty if none was published
+     */
+    Snapshot read() const
+    {
+        std::size_t index = published_.load();
+        while (index != None)
+        {
+            Slot& slot = slots_[index];
+            slot.readers.fetch_add(1);
+            const std::size_t check = published_.load();
+            if (check == index)
+            {
+                return Snapshot(&slot);
+            }
+            slot.readers.fetch_sub(1, std::memory_order_release); // republished meanwhile, may be rewritten
+            index = check;
+        }
+        return Snapshot();
+    }
+
+private:
+    static constexpr std::size_t None = Slots;
+
+    mutable std::array<Slot, Slots> slots_;
+    alignas(64) std::atomic<std::size_t> published_{None};
+};
+} // namespace synchro
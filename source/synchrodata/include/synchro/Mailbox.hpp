@@ -0,0 +1,171 @@
+#pragma once
+
+#include "Executor.hpp"
+#include "util/SpscRing.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace synchro
+{
+/// @brief Behaviour of a mailbox when its subscriber is slower than its producer
+enum class MailboxMode
+{
+    Block,   ///< lossless, sending waits while the ring of the subscriber is full, the executor must not run on the sending thread
+    Conflate ///< only the newest element is kept until the subscriber takes it, suited to optional types
+};
+
+/**
+ * @brief Mailbox of a subscriber, decoupling it from the producer and the other subscribers
+ *
+ * Elements are pushed in a bounded single-producer single-consumer ring, or in a single conflating
+ * slot, and a drain task is posted to the executor while elements are pending. Notifications run one
+ * at a time, in order, so that a slow subscriber only slows down its own mailbox: with
+ * MailboxMode::Conflate it receives fewer, newer elements, and never blocks the producer.
+ *
+ * With MailboxMode::Block, a producer finding the ring full waits on a condition variable, notified by
+ * the drain task once it took an element.
+ *
+ * Elements must not be pushed concurrently, i.e. the broadcaster of the subscriber must not be sent
+ * to from several threads at a time. Elements already pushed when the subscriber is disconnected are
+ * still notified.
+ */
+template<class T>
+class Mailbox : public std::enable_shared_from_this<Mailbox<T>>
+{
+public:
+    using Callback = std::function<void(const std::shared_ptr<T>&)>; ///< Callback of the subscriber
+
+    static constexpr std::size_t DefaultCapacity = 1024; ///< default ring capacity
+
+    /**
+     * @brief Create a mailbox
+     * @param cbk callback of the subscriber
+     * @param executor executor running the callback
+     * @param mode behaviour with a slow subscriber
+     * @param capacity ring capacity with MailboxMode::Block, rounded up to a power of two
+     * @returns the mailbox
+     */
+    static std::shared_ptr<Mailbox> create(Callback&& cbk, Executor executor, MailboxMode mode, std::size_t capacity = DefaultCapacity)
+    {
+        return std::shared_ptr<Mailbox>(new Mailbox(std::move(cbk), std::move(executor), mode, capacity));
+    }
+
+    /**
+     * @brief Push an element, from the single producer
+     * @param data element to notify
+     */
+    void push(const std::shared_ptr<T>& data)
+    {
+        if (mode_ == MailboxMode::Conflate)
+        {
+            if (exchange(data))
+            {
+                conflated_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            auto element = data;
+            if (!ring_->tryPush(std::move(element)))
+            {
+                std::unique_lock<std::mutex> lock(spaceMutex_);
+                waiting_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst); // either the drain task sees waiting_, or the push sees its pop
+                space_.wait(lock, [this, &element] { return ring_->tryPush(std::move(element)); });
+                waiting_.store(false, std::memory_order_relaxed);
+            }
+        }
+        if (pending_.fetch_add(1) == 0)
+        {
+            executor_.post([self = this->shared_from_this()] { self->drain(); });
+        }
+    }
+
+    /// @returns number of elements replaced by newer ones before being notified, with MailboxMode::Conflate
+    std::size_t conflated() const { return conflated_.load(std::memory_order_relaxed); }
+
+private:
+    Mailbox(Callback&& cbk, Executor executor, MailboxMode mode, std::size_t capacity)
+        : callback_(std::move(cbk)), executor_(std::move(executor)), mode_(mode)
+    {
+        if (mode_ == MailboxMode::Block)
+        {
+            ring_.emplace(capacity);
+        }
+    }
+
+    // one push by decrement, conflated pushes leave the slot empty
+    void drain()
+    {
+        do
+        {
+            if (mode_ == MailboxMode::Conflate)
+            {
+                if (auto data = exchange(nullptr))
+                {
+                    callback_(data);
+                }
+            }
+            else if (auto data = ring_->pop())
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (waiting_.load(std::memory_order_relaxed))
+                {
+                    std::lock_guard<std::mutex> lock(spaceMutex_); // the producer is waiting, or about to check the ring again
+                    space_.notify_one();
+                }
+                callback_(*data);
+            }
+        } while (pending_.fetch_sub(1) > 1);
+    }
+
+    std::shared_ptr<T> exchange(std::shared_ptr<T> data)
+    {
+        while (lock_.test_and_set(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+        std::swap(latest_, data);
+        lock_.clear(std::memory_order_release);
+        return data;
+    }
+
+private:
+    Callback callback_;
+    Executor executor_;
+    const MailboxMode mode_;
+    std::optional<util::SpscRing<std::shared_ptr<T>>> ring_; // with MailboxMode::Block
+    std::mutex spaceMutex_;
+    std::condition_variable space_;
+    std::atomic_flag lock_ = ATOMIC_FLAG_INIT; // conflating slot, only contended by the producer and the drain task
+    std::shared_ptr<T> latest_;
+    std::atomic_size_t pending_   = 0;
+    std::atomic_size_t conflated_ = 0;
+    std::atomic_bool waiting_     = false; // producer waiting for space in the ring
+};
+
+/**
+ * @brief Bind a notification callback to a mailbox
+ *
+ * @param cbk callback with prototype void(const std::shared_ptr<T>&)
+ * @param executor executor running the callback
+ * @param mode behaviour with a slow subscriber
+ * @param capacity ring capacity with MailboxMode::Block
+ * @returns callback pushing notifications to the mailbox
+ */
+template<class T>
+std::function<void(const std::shared_ptr<T>&)> bindMailbox(std::function<void(const std::shared_ptr<T>&)>&& cbk, const Executor& executor, MailboxMode mode,
+                                                           std::size_t capacity = Mailbox<T>::DefaultCapacity)
+{
+    auto mailbox = Mailbox<T>::create(std::move(cbk), executor, mode, capacity);
+    return [mailbox](const std::shared_ptr<T>& data) { mailbox->push(data); };
+}
+} // namespace synchro
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "util/SynchroUtils.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <typeinfo>
+
+namespace synchro
+{
+/**
+ * @brief Lock-free latency histogram
+ *
+ * Values (nanoseconds) are counted in log-linear buckets in the manner of HDR histograms: 8 linear
+ * sub-buckets by power of two, i.e. a relative precision of 12.5%. Values above 2^40 ns are counted
+ * in the last bucket. Recording is one relaxed atomic increment.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr std::size_t SubBits     = 3;                                        ///< precision bits
+    static constexpr std::size_t SubBuckets  = std::size_t(1) << SubBits;                ///< sub-buckets by power of two
+    static constexpr std::size_t MaxExponent = 40;                                       ///< highest power of two
+    static constexpr std::size_t Buckets     = SubBuckets * (MaxExponent - SubBits + 2); ///< number of buckets
+
+    /// @brief Copy of the histogram counts
+    struct Snapshot
+    {
+        std::array<std::uint64_t, Buckets> counts{}; ///< count by bucket
+
+        /// @returns number of recorded values
+        std::uint64_t count() const
+        {
+            std::uint64_t total = 0;
+            for (auto c : counts)
+            {
+                total += c;
+            }
+            return total;
+        }
+
+        /**
+         * @brief Approximate percentile
+         * @param quantile in [0, 1]
+         * @returns upper bound of the bucket holding the quantile, 0 if empty
+         */
+        std::uint64_t percentile(double quantile) const
+        {
+            const std::uint64_t total = count();
+            if (total == 0)
+            {
+                return 0;
+            }
+            auto rank                = static_cast<std::uint64_t>(quantile * static_cast<double>(total));
+            rank                     = rank == 0 ? 1 : (rank > total ? total : rank);
+            std::uint64_t cumulative = 0;
+            for (std::size_t i = 0; i < Buckets; ++i)
+            {
+                cumulative += counts[i];
+                if (cumulative >= rank)
+                {
+                    return upperBound(i);
+                }
+            }
+            return upperBound(Buckets - 1);
+        }
+    };
+
+public:
+    /**
+     * @brief Record a value
+     * @param nanoseconds value to record
+     */
+    void record(std::uint64_t nanoseconds) { counts_[bucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed); }
+
+    /// @returns copy of the counts, may be called from any thread
+    Snapshot snapshot() const
+    {
+        Snapshot snapshot;
+        for (std::size_t i = 0; i < Buckets; ++i)
+        {
+            snapshot.counts[i] = counts_[i].load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    /// @returns bucket index of a value
+    static std::size_t bucket(std::uint64_t value)
+    {
+        if (value < SubBuckets)
+        {
+            return static_cast<std::size_t>(value);
+        }
+        std::size_t exponent = SubBits;
+        while (exponent < 63 && (value >> (exponent + 1)) != 0)
+        {
+            ++exponent;
+        }
+        if (exponent > MaxExponent)
+        {
+            return Buckets - 1;
+        }
+        const auto sub = static_cast<std::size_t>(value >> (exponent - SubBits)) - SubBuckets;
+        return SubBuckets + (exponent - SubBits) * SubBuckets + sub;
+    }
+
+    /// @returns highest value counted in a bucket
+    static std::uint64_t upperBound(std::size_t index)
+    {
+        if (index < SubBuckets)
+        {
+            return index;
+        }
+        const std::size_t exponent = (index - SubBuckets) / SubBuckets + SubBits;
+        const std::size_t sub      = (index - SubBuckets) % SubBuckets;
+        return ((SubBuckets + sub + 1) << (exponent - SubBits)) - 1;
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, Buckets> counts_{};
+};
+
+/// @brief Copy of the metrics of a type of synchronized data
+struct TypeMetricsSnapshot
+{
+    const char* name          = nullptr;    ///< implementation defined type name
+    std::uint64_t received    = 0;          ///< elements sent to the synchronized data
+    std::uint64_t overwritten = 0;          ///< pending elements replaced by a newer one before being notified
+    std::uint64_t dropped     = 0;          ///< elements dropped by a full pending list
+    std::uint64_t dispatched  = 0;          ///< elements notified
+    std::uint64_t depth       = 0;          ///< current number of pending elements
+    LatencyHistogram::Snapshot synchronize; ///< time from the first pending element to its notification, nanoseconds
+    LatencyHistogram::Snapshot dispatch;    ///< time spent in callbacks by notification, nanoseconds
+};
+
+/**
+ * @brief Metrics of synchronized data
+ *
+ * Counters and histograms by type, updated with relaxed atomic operations from the sending thread.
+ * snapshot may be called from any thread without synchronizing with the sending thread.
+ */
+template<class Types>
+class SynchroMetrics;
+/// @brief Specialization for tuple of types
+template<class... Ts>
+class SynchroMetrics<std::tuple<Ts...>>
+{
+public:
+    using Clock     = std::chrono::steady_clock; ///< Clock used for latencies
+    using TimePoint = Clock::time_point;         ///< Time point type
+
+    /// @returns current time
+    static TimePoint now() { return Clock::now(); }
+
+    /// @brief Count an element of type T sent
+    template<class T>
+    void received()
+    {
+        get<T>().received.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Count a pending element of type T replaced before being notified
+    template<class T>
+    void overwritten()
+    {
+        get<T>().overwritten.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Count an element of type T dropped by a full pending list
+    template<class T>
+    void dropped()
+    {
+        get<T>().dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Mark type T as pending, the first pending time is kept until synchronized is called
+     * @param depth number of pending elements of type T
+     */
+    template<class T>
+    void pending(std::size_t depth = 1)
+    {
+        auto& metrics = get<T>();
+        if (!metrics.pending)
+        {
+            metrics.pending      = true;
+            metrics.pendingSince = now();
+        }
+        metrics.depth.store(depth, std::memory_order_relaxed);
+    }
+
+    /// @brief Record time to synchronize if type T was pending
+    template<class T>
+    void synchronized()
+    {
+        auto& metrics = get<T>();
+        if (metrics.pending)
+        {
+            metrics.pending = false;
+            metrics.synchronize.record(elapsed(metrics.pendingSince));
+            metrics.depth.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Record a notification of type T
+     * @param begin time before callbacks were called
+     */
+    template<class T>
+    void dispatched(TimePoint begin)
+    {
+        auto& metrics = get<T>();
+        metrics.dispatched.fetch_add(1, std::memory_order_relaxed);
+        metrics.dispatch.record(elapsed(begin));
+    }
+
+    /// @returns copy of the metrics of each type, in required, optional then listed types order
+    std::array<TypeMetricsSnapshot, sizeof...(Ts)> snapshot() const
+    {
+        std::array<TypeMetricsSnapshot, sizeof...(Ts)> snapshot;
+        const std::array<const char*, sizeof...(Ts)> names = {typeid(Ts).name()...};
+        for (std::size_t i = 0; i < sizeof...(Ts); ++i)
+        {
+            const auto& metrics     = types_[i];
+            snapshot[i].name        = names[i];
+            snapshot[i].received    = metrics.received.load(std::memory_order_relaxed);
+            snapshot[i].overwritten = metrics.overwritten.load(std::memory_order_relaxed);
+            snapshot[i].dropped     = metrics.dropped.load(std::memory_order_relaxed);
+            snapshot[i].dispatched  = metrics.dispatched.load(std::memory_order_relaxed);
+            snapshot[i].depth       = metrics.depth.load(std::memory_order_relaxed);
+            snapshot[i].synchronize = metrics.synchronize.snapshot();
+            snapshot[i].dispatch    = metrics.dispatch.snapshot();
+        }
+        return snapshot;
+    }
+
+private:
+    /// @brief Metrics of a type, on its own cache lines so that types do not interfere
+    struct alignas(64) TypeMetrics
+    {
+        std::atomic<std::uint64_t> received{0};
+        std::atomic<std::uint64_t> overwritten{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::uint64_t> dispatched{0};
+        std::atomic<std::uint64_t> depth{0};
+        LatencyHistogram synchronize;
+        LatencyHistogram dispatch;
+        TimePoint pendingSince; // sending thread only
+        bool pending = false;   // sending thread only
+    };
+
+    template<class T>
+    TypeMetrics& get()
+    {
+        return types_[util::Index<T, std::tuple<Ts...>>::value];
+    }
+
+    static std::uint64_t elapsed(TimePoint begin)
+    {
+        const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(now() - begin).count();
+        return duration > 0 ? static_cast<std::uint64_t>(duration) : 0;
+    }
+
+private:
+    std::array<TypeMetrics, sizeof...(Ts)> types_;
+};
+
+/**
+ * @brief Disabled metrics
+ *
+ * Same interface as SynchroMetrics with empty functions, so that instrumentation is compiled out.
+ */
+template<class Types>
+class NoMetrics
+{
+public:
+    /// @brief Empty time point
+    struct TimePoint
+    {
+    };
+
+    /// @returns empty time point
+    static TimePoint now() { return {}; }
+    /// @brief Does nothing
+    template<class T>
+    void received()
+    {
+    }
+    /// @brief Does nothing
+    template<class T>
+    void overwritten()
+    {
+    }
+    /// @brief Does nothing
+    template<class T>
+    void dropped()
+    {
+    }
+    /// @brief Does nothing
+    template<class T>
+    void pending(std::size_t = 1)
+    {
+    }
+    /// @brief Does nothing
+    template<class T>
+    void synchronized()
+    {
+    }
+    /// @brief Does nothing
+    template<class T>
+    void dispatched(TimePoint)
+    {
+    }
+    /// @returns no metrics
+    std::array<TypeMetricsSnapshot, 0> snapshot() const { return {}; }
+};
+} // namespace synchro
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace synchro
+{
+/// @brief Copy of the allocation counters of an ObjectPool
+struct PoolStats
+{
+    std::uint64_t hits   = 0; ///< allocations served by the pool
+    std::uint64_t misses = 0; ///< allocations falling back to the heap, pool exhausted
+};
+
+/**
+ * @brief Pool of elements to send without heap allocation
+ *
+ * make is the pooled equivalent of std::make_shared: the element and its reference counts are
+ * allocated in one block taken from a lock-free free list, and the block is recycled when the last
+ * pointer is released, from any thread. Once the storage of capacity blocks is allocated, on first
+ * make, making elements does no heap allocation until the pool is exhausted: further elements are
+ * then allocated on the heap and counted as misses.
+ *
+ * Elements may outlive the pool, the storage is released with the last of them.
+ */
+template<class T>
+class ObjectPool
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types cannot be pooled");
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity number of pooled blocks
+     */
+    explicit ObjectPool(std::size_t capacity) : arena_(new Arena(capacity)) {}
+
+    ~ObjectPool() { arena_->release(); }
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief Make an element
+     * @param args arguments of the element constructor
+     * @returns pointer to the element
+     */
+    template<class... Args>
+    std::shared_ptr<T> make(Args&&... args)
+    {
+        return std::allocate_shared<T>(Allocator<T>(arena_), std::forward<Args>(args)...);
+    }
+
+    /// @returns allocation counters, may be called from any thread
+    PoolStats stats() const { return {arena_->hits.load(std::memory_order_relaxed), arena_->misses.load(std::memory_order_relaxed)}; }
+
+    /// @returns number of pooled blocks
+    std::size_t capacity() const { return arena_->capacity; }
+
+private:
+    /// @brief Fixed size blocks with a free list of indices tagged against ABA, deleted with the pool and the last block
+    struct Arena
+    {
+        explicit Arena(std::size_t count) : capacity(count), next(std::make_unique<std::atomic<std::uint32_t>[]>(count)) {}
+
+        ~Arena()
+        {
+            if (storage)
+            {
+                ::operator delete(storage, std::align_val_t(Alignment));
+            }
+        }
+
+        void* allocate(std::size_t size, std::size_t alignment)
+        {
+            std::call_once(init, [this, size] { setup(size); });
+            users.fetch_add(1, std::memory_order_relaxed);
+            if (size <= blockSize && alignment <= Alignment)
+            {
+                std::uint64_t head = free.load(std::memory_order_acquire);
+                while (index(head) != 0)
+                {
+                    const std::uint32_t slot = index(head) - 1;
+                    const std::uint64_t next = tagged(tag(head) + 1, this->next[slot].load(std::memory_order_relaxed));
+                    if (free.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+                    {
+                        hits.fetch_add(1, std::memory_order_relaxed);
+                        return storage + slot * blockSize;
+                    }
+                }
+            }
+            misses.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+
+        void deallocate(void* pointer)
+        {
+            auto* block = static_cast<std::byte*>(pointer);
+            if (!storage || block < storage || block >= storage + capacity * blockSize)
+            {
+                ::operator delete(pointer);
+            }
+            else
+            {
+                const auto slot    = static_cast<std::uint32_t>((block - storage) / blockSize);
+                std::uint64_t head = free.load(std::memory_order_relaxed);
+                do
+                {
+                    next[slot].store(index(head), std::memory_order_relaxed);
+                } while (!free.compare_exchange_weak(head, tagged(tag(head) + 1, slot + 1), std::memory_order_release, std::memory_order_relaxed));
+            }
+            release();
+        }
+
+        void release()
+        {
+            if (users.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                delete this;
+            }
+        }
+
+        // block size is only known on first allocation, from the control block type of allocate_shared
+        void setup(std::size_t size)
+        {
+            blockSize = (size + Alignment - 1) / Alignment * Alignment;
+            storage   = static_cast<std::byte*>(::operator new(capacity * blockSize, std::align_val_t(Alignment)));
+            for (std::size_t i = 0; i < capacity; ++i)
+            {
+                next[i].store(static_cast<std::uint32_t>(i + 1 < capacity ? i + 2 : 0), std::memory_order_relaxed);
+            }
+            free.store(tagged(0, capacity > 0 ? 1 : 0), std::memory_order_release);
+        }
+
+        static std::uint32_t index(std::uint64_t head) { return static_cast<std::uint32_t>(head); }
+        static std::uint32_t tag(std::uint64_t head) { return static_cast<std::uint32_t>(head >> 32); }
+        static std::uint64_t tagged(std::uint32_t tag, std::uint32_t index) { return (std::uint64_t(tag) << 32) | index; }
+
+        static constexpr std::size_t Alignment = alignof(std::max_align_t);
+
+        const std::size_t capacity;
+        std::size_t blockSize = 0;
+        std::byte* storage    = nullptr;
+        std::once_flag init;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> next; // 1-based index of next free block, 0 for none
+        std::atomic<std::uint64_t> free{0};                 // tag and 1-based index of first free block
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+        std::atomic<std::size_t> users{1}; // pool and allocated blocks
+    };
+
+    /// @brief Allocator of allocate_shared, single objects come from the arena
+    template<class U>
+    struct Allocator
+    {
+        using value_type = U;
+
+        explicit Allocator(Arena* a) : arena(a) {}
+        template<class V>
+        Allocator(const Allocator<V>& other) : arena(other.arena)
+        {
+        }
+
+        U* allocate(std::size_t n) { return static_cast<U*>(arena->allocate(n * sizeof(U), alignof(U))); }
+
+        void deallocate(U* pointer, std::size_t) { arena->deallocate(pointer); }
+
+        template<class V>
+        bool operator==(const Allocator<V>& other) const
+        {
+            return arena == other.arena;
+        }
+        template<class V>
+        bool operator!=(const Allocator<V>& other) const
+        {
+            return arena != other.arena;
+        }
+
+        Arena* arena;
+    };
+
+private:
+    Arena* arena_;
+};
+} // namespace synchro
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "SynchronizedData.hpp"
+
+#include <boost/signals2.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace synchro
+{
+/**
+ * @brief Synchronization stage of a pipeline
+ *
+ * A stage synchronizes its inputs like SynchronizedData<R, O, L> and makes one Out element from
+ * each synchronized set. Inputs are elements of the pipeline poolers or outputs of previous stages.
+ */
+template<class Out, class R, class O = Optional<>, class L = List<>>
+struct Stage
+{
+    using Output        = Out;                       ///< Output type
+    using RequiredTypes = R;                         ///< Required types
+    using OptionalTypes = O;                         ///< Optional types
+    using ListTypes     = L;                         ///< Listed types
+    using Set           = SynchronizedSet<R, O, L>; ///< Synchronized set type
+    /// @brief Function making the output of a set, the output is dropped if null
+    using Function = std::function<std::shared_ptr<Out>(const Set&)>;
+    /// @brief Tuple of input types
+    using Inputs = typename util::Concat<typename R::TupleType, typename O::TupleType, typename L::TupleType>::type;
+};
+
+/// @brief Trait class to define the stages of a pipeline, in an order where each stage follows the stages of its inputs
+template<class... Ss>
+using Stages = TupleWrapper<Ss...>;
+
+/**
+ * @brief Pipeline of synchronization stages declared at compile time
+ *
+ * The graph of stages is resolved at compile time: an output is sent directly to the synchronized
+ * data of each stage consuming it, and inputs which are not outputs of any stage are received from
+ * a pooler each, sent directly to the stages consuming them. Adjacent stages are thus fused in one
+ * dispatch, without pooler, signal or allocation between them besides the output itself (which may
+ * come from an ObjectPool).
+ *
+ * Stages run inline, in the thread sending their inputs, unless runOn gives a stage its own
+ * executor: independent branches may then run in parallel. An inline stage fed from several
+ * contexts, e.g. by a stage with its own executor and by a pooler, is run on a serial executor of
+ * its own, posting to the executor of a stage feeding it, so that its inputs are never sent
+ * concurrently.
+ *
+ * Requirements for Pooler and Policy are the same as for Synchronizer; stages must be listed after
+ * the stages of their inputs, and each output type must be produced by a single stage.
+ */
+template<template<class> class Pooler, class S, class Policy = DefaultPolicy>
+class Pipeline;
+
+/// @brief Specialization for stages wrapper
+template<template<class> class Pooler, class... Ss, class Policy>
+class Pipeline<Pooler, Stages<Ss...>, Policy>
+{
+public:
+    using Outputs = std::tuple<typename Ss::Output...>; ///< Tuple of output types
+    /// @brief Tuple of input types received from poolers, in order of first use by stages
+    using Inputs = typename util::Unique<typename util::Concat<typename Ss::Inputs...>::type, Outputs>::type;
+
+    /// @brief Trait class to define tuple of Poolers
+    template<class T>
+    struct Poolers;
+    /// @brief Specialization for tuples
+    template<class... Ts>
+    struct Poolers<std::tuple<Ts...>>
+    {
+        using type = std::tuple<Pooler<Ts>...>; ///< Tuple of poolers type definition
+    };
+    using InputPoolers = typename Poolers<Inputs>::type; ///< Tuple of poolers for input types
+
+    /// @brief Stage type by index
+    template<std::size_t I>
+    using StageAt = std::tuple_element_t<I, std::tuple<Ss...>>;
+
+    /// @brief Synchronized data type of a stage
+    template<std::size_t I>
+    using Data = SynchronizedData<typename StageAt<I>::RequiredTypes, typename StageAt<I>::OptionalTypes, typename StageAt<I>::ListTypes, Policy>;
+
+    /// @brief Broadcaster type by output, as defined by the policy
+    template<class T>
+    using Sender = typename Policy::template Broadcaster<T>;
+
+    /// @brief Connection type by output
+    template<class T>
+    using Connection = typename Sender<T>::Connection;
+
+public:
+    /**
+     * @brief Constructor with default constructed poolers
+     * @param functions function of each stage
+     */
+    explicit Pipeline(typename Ss::Function... functions) : Pipeline(InputPoolers{}, std::move(functions)...) {}
+
+    /**
+     * @brief Constructor
+     * @param poolers the tuple of poolers for input types
+     * @param functions function of each stage
+     */
+    explicit Pipeline(InputPoolers&& poolers, typename Ss::Function... functions) : stages_(std::move(functions)...), poolers_(std::move(poolers))
+    {
+        static_assert(std::is_same_v<typename util::Unique<Outputs>::type, Outputs>, "each output type must be produced by a single stage");
+        static_assert(isOrdered(std::index_sequence_for<Ss...>()), "stages must be listed after the stages of their inputs");
+        connectStages(std::index_sequence_for<Ss...>());
+        std::apply([this](auto&... pooler) { (..., connect(pooler)); }, poolers_);
+    }
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * @brief Register callback for output type T
+     *
+     * @param cbk callback with prototype void(const std::shared_ptr<T>&), called before the stages consuming the output
+     * @returns broadcaster connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(typename Sender<T>::Callback&& cbk)
+    {
+        static_assert(util::Contains<T, Outputs>(), "T must be an output of a stage");
+        subscribed_[util::Index<T, Outputs>::value] = true;
+        return std::get<Sender<T>>(outputs_).onReceived(std::forward<typename Sender<T>::Callback>(cbk));
+    }
+
+    /**
+     * @brief Run a stage on its own executor, must not be called while elements are sent or processed
+     *
+     * Inputs of the stage are posted in order to the executor, see SerialExecutor; the pipeline must
+     * outlive posted tasks. Inline stages now fed from several contexts are given a serial executor.
+     *
+     * @param executor executor running the stage and its outputs, inline to run the stage inline again
+     */
+    template<std::size_t I>
+    void runOn(const Executor& executor)
+    {
+        std::get<I>(stages_).executor = executor;
+        std::array<std::size_t, Count> contexts{};
+        std::array<Executor, Count> executors{};
+        resolve(contexts, executors, std::index_sequence_for<Ss...>());
+    }
+
+    /**
+     * @brief Retrieve synchronized data of a stage
+     * @returns the synchronized data of stage I
+     */
+    template<std::size_t I>
+    Data<I>& stage()
+    {
+        return std::get<I>(stages_).data;
+    }
+
+    /**
+     * @brief Retrieve pooler of an input type
+     * @returns the pooler for type T
+     */
+    template<class T>
+    Pooler<T>& pooler()
+    {
+        static_assert(util::Contains<T, Inputs>(), "T must be an input which is not an output of a stage");
+        return std::get<Pooler<T>>(poolers_);
+    }
+
+private:
+    static constexpr std::size_t Count = sizeof...(Ss);
+
+    /// @brief Synchronized data and function of a stage
+    template<class S>
+    struct StageState
+    {
+        explicit StageState(typename S::Function f) : function(std::move(f)) {}
+
+        SynchronizedData<typename S::RequiredTypes, typename S::OptionalTypes, typename S::ListTypes, Policy> data;
+        typename S::Function function;
+        Executor executor;                      // given by runOn
+        std::shared_ptr<SerialExecutor> serial; // null when inline
+    };
+
+    /// @returns index of the stage producing T, Count if none
+    template<class T>
+    static constexpr std::size_t producer()
+    {
+        if constexpr (util::Contains<T, Outputs>())
+        {
+            return util::Index<T, Outputs>::value;
+        }
+        else
+        {
+            return Count;
+        }
+    }
+
+    template<std::size_t I, class... Ts>
+    static constexpr bool inputsBefore(std::tuple<Ts...>*)
+    {
+        return (... && (producer<Ts>() < I || producer<Ts>() == Count));
+    }
+
+    template<std::size_t... Is>
+    static constexpr bool isOrdered(std::index_sequence<Is...>)
+    {
+        return (... && inputsBefore<Is>(static_cast<typename StageAt<Is>::Inputs*>(nullptr)));
+    }
+
+    /// @returns index of the stage producing each input, Count for inputs received from poolers
+    template<class... Ts>
+    static constexpr std::array<std::size_t, sizeof...(Ts)> producers(std::tuple<Ts...>*)
+    {
+        return {producer<Ts>()...};
+    }
+
+private:
+    template<std::size_t... Is>
+    void connectStages(std::index_sequence<Is...>)
+    {
+        // sets are handled directly by the synchronization path of each stage, without signal
+        (..., std::get<Is>(stages_).data.setSynchronizedHandler([this](const auto& set) { emit<Is>(set); }));
+    }
+
+    template<std::size_t... Is>
+    void resolve(std::array<std::size_t, Count>& contexts, std::array<Executor, Count>& executors, std::index_sequence<Is...>)
+    {
+        (..., resolve<Is>(contexts, executors));
+    }
+
+    // context of a stage: index of the stage whose serial executor runs it, Count for the threads sending to the poolers
+    template<std::size_t I>
+    void resolve(std::array<std::size_t, Count>& contexts, std::array<Executor, Count>& executors)
+    {
+        auto& stage  = std::get<I>(stages_);
+        stage.serial = nullptr;
+        contexts[I]  = I;
+        executors[I] = stage.executor;
+        if (!stage.executor.isInline())
+        {
+            stage.serial = SerialExecutor::create(stage.executor);
+            return;
+        }
+
+        constexpr auto inputs = producers(static_cast<typename StageAt<I>::Inputs*>(nullptr));
+        std::size_t context   = inputs[0] == Count ? Count : contexts[inputs[0]];
+        for (const std::size_t producer : inputs)
+        {
+            const std::size_t input = producer == Count ? Count : contexts[producer];
+            if (input == context)
+            {
+                continue;
+            }
+            // fed from several contexts, serialized on the executor of one of them
+            const std::size_t owner = input == Count ? context : input;
+            stage.serial            = SerialExecutor::create(executors[owner]);
+            executors[I]            = executors[owner];
+            return;
+        }
+        contexts[I] = context;
+    }
+
+    template<class T>
+    void connect(Pooler<T>& pooler)
+    {
+        connections_.push_back(pooler.onReceived([this](const std::shared_ptr<T>& data) { feed(data, std::index_sequence_for<Ss...>()); }));
+    }
+
+    template<std::size_t I, class Set>
+    void emit(const Set& set)
+    {
+        if (auto output = std::get<I>(stages_).function(set))
+        {
+            if (subscribed_[I])
+            {
+                std::get<Sender<typename StageAt<I>::Output>>(outputs_).send(output);
+            }
+            feed(output, std::index_sequence_for<Ss...>());
+        }
+    }
+
+    template<class T, std::size_t... Is>
+    void feed(const std::shared_ptr<T>& data, std::index_sequence<Is...>)
+    {
+        (..., deliver<Is>(data));
+    }
+
+    template<std::size_t I, class T>
+    void deliver(const std::shared_ptr<T>& data)
+    {
+        if constexpr (util::Contains<T, typename StageAt<I>::Inputs>())
+        {
+            auto& stage = std::get<I>(stages_);
+            if (stage.serial)
+            {
+                stage.serial->post([&stage, data] { stage.data.send(data); });
+                return;
+            }
+            stage.data.send(data);
+        }
+    }
+
+private:
+    std::tuple<Sender<typename Ss::Output>...> outputs_;
+    std::array<std::atomic_bool, Count> subscribed_{}; // outputs are only broadcast once subscribed
+    std::tuple<StageState<Ss>...> stages_;
+    std::vector<boost::signals2::connection> connections_;
+    InputPoolers poolers_; // last, destroyed first
+};
+} // namespace synchro
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Broadcaster.hpp"
+#include "FastBroadcaster.hpp"
+#include "Latest.hpp"
+#include "Metrics.hpp"
+
+namespace synchro
+{
+/**
+ * @brief Default policy for synchronized data
+ *
+ * A policy gathers the implementation choices of SynchronizedData and Synchronizer. Custom policies
+ * should derive from DefaultPolicy and only redefine the members they change.
+ */
+struct DefaultPolicy
+{
+    /// @brief Broadcaster used to notify elements, based on boost::signals2
+    template<class T>
+    using Broadcaster = synchro::Broadcaster<T>;
+
+    /// @brief Instrumentation for the tuple of all synchronized types, disabled (compiled out)
+    template<class Types>
+    using Metrics = NoMetrics<Types>;
+
+    /// @brief Publication of the latest synchronized set, disabled (compiled out)
+    template<class Set>
+    using Latest = NoLatest<Set>;
+};
+
+/// @brief Policy notifying elements through lock-free, allocation-free FastBroadcaster
+struct FastPolicy : DefaultPolicy
+{
+    /// @brief Broadcaster used to notify elements
+    template<class T>
+    using Broadcaster = FastBroadcaster<T>;
+};
+
+/// @brief Policy recording per type counters and latency histograms
+struct MetricsPolicy : DefaultPolicy
+{
+    /// @brief Instrumentation for the tuple of all synchronized types
+    template<class Types>
+    using Metrics = SynchroMetrics<Types>;
+};
+
+/// @brief Policy publishing the latest synchronized set to polling readers, see SynchronizedData::latest
+struct LatestPolicy : DefaultPolicy
+{
+    /// @brief Publication of the latest synchronized set
+    template<class Set>
+    using Latest = LatestSet<Set>;
+};
+} // namespace synchro
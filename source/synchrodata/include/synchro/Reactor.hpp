@@ -0,0 +1,295 @@
+#pragma once
+
+#include "Broadcaster.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace synchro
+{
+/**
+ * @brief Event loop multiplexing file descriptors on a few threads
+ *
+ * Sources (sockets, pipes, eventfd, timerfd...) are watched by a single epoll instance, shared by the
+ * threads of the reactor. A source is armed for one event at a time, so that its handler never runs
+ * concurrently with itself, and is rearmed once the handler returns, unless the event reported an
+ * error or a hang up.
+ *
+ * Handlers of distinct sources may run concurrently when the reactor has several threads: sources
+ * feeding the same synchronized data must then be handled by a reactor with a single thread, or
+ * feed ConcurrentSynchronizedData.
+ */
+class Reactor
+{
+public:
+    using Handler = std::function<void(std::uint32_t events)>; ///< Handler of the events of a source
+
+    /// @brief Registration of a source, removes it on destruction
+    class Registration
+    {
+    public:
+        /// @brief Constructor of an empty registration
+        Registration() = default;
+        /// @brief Destructor, removes the source
+        ~Registration() { reset(); }
+
+        Registration(Registration&& other) noexcept : reactor_(std::exchange(other.reactor_, nullptr)), id_(other.id_) {}
+        Registration& operator=(Registration&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                reactor_ = std::exchange(other.reactor_, nullptr);
+                id_      = other.id_;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Remove the source
+         *
+         * Once reset returns, the handler is not running, unless reset is called by the handler itself.
+         */
+        void reset()
+        {
+            if (reactor_)
+            {
+                std::exchange(reactor_, nullptr)->remove(id_);
+            }
+        }
+
+    private:
+        friend class Reactor;
+        Registration(Reactor* reactor, std::uint64_t id) : reactor_(reactor), id_(id) {}
+
+    private:
+        Reactor* reactor_ = nullptr;
+        std::uint64_t id_ = 0;
+    };
+
+public:
+    /**
+     * @brief Constructor, starts the threads
+     * @param threads number of threads waiting for events
+     * @throws std::system_error if the epoll instance cannot be created
+     */
+    explicit Reactor(std::size_t threads = 1)
+    {
+        epoll_ = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_ < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "epoll_create1");
+        }
+        wakeup_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        epoll_event event{};
+        event.events   = EPOLLIN; // level triggered and never read: wakes up all threads once stopping
+        event.data.u64 = 0;
+        if (wakeup_ < 0 || ::epoll_ctl(epoll_, EPOLL_CTL_ADD, wakeup_, &event) < 0)
+        {
+            const int error = errno;
+            close();
+            throw std::system_error(error, std::generic_category(), "eventfd");
+        }
+        threads = threads > 0 ? threads : 1;
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            threads_.emplace_back([this] { run(); });
+        }
+    }
+
+    /// @brief Destructor, stops the threads, registrations must be reset before
+    ~Reactor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        const std::uint64_t one = 1;
+        (void)::write(wakeup_, &one, sizeof(one));
+        for (auto& thread : threads_)
+        {
+            thread.join();
+        }
+        close();
+    }
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    /**
+     * @brief Watch a file descriptor
+     *
+     * @param fd file descriptor, owned by the caller, must stay open until the registration is reset
+     * @param events epoll events to watch, e.g. EPOLLIN
+     * @param handler handler called from a thread of the reactor with the received events
+     * @returns registration to store
+     * @throws std::system_error if the file descriptor cannot be watched
+     */
+    Registration add(int fd, std::uint32_t events, Handler handler)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::uint64_t id = ++lastId_;
+        auto source            = std::make_shared<Source>(Source{fd, events | EPOLLONESHOT, std::move(handler), {}});
+        epoll_event event{};
+        event.events   = source->events;
+        event.data.u64 = id;
+        if (::epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event) < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "epoll_ctl");
+        }
+        sources_.emplace(id, std::move(source));
+        return Registration(this, id);
+    }
+
+private:
+    struct Source
+    {
+        int fd;
+        std::uint32_t events;
+        Handler handler;
+        std::thread::id running; // thread running the handler, if any
+    };
+
+    void run()
+    {
+        std::vector<epoll_event> events(64);
+        while (true)
+        {
+            const int count = ::epoll_wait(epoll_, events.data(), static_cast<int>(events.size()), -1);
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stop_)
+            {
+                return;
+            }
+            for (int i = 0; i < count; ++i)
+            {
+                // sources are looked up by id: events of removed sources are ignored
+                auto found = sources_.find(events[i].data.u64);
+                if (found == sources_.end())
+                {
+                    continue;
+                }
+                auto source     = found->second;
+                source->running = std::this_thread::get_id();
+                lock.unlock();
+                source->handler(events[i].events);
+                lock.lock();
+                source->running = std::thread::id();
+                if (sources_.count(events[i].data.u64) && !(events[i].events & (EPOLLERR | EPOLLHUP)))
+                {
+                    epoll_event event{};
+                    event.events   = source->events;
+                    event.data.u64 = events[i].data.u64;
+                    (void)::epoll_ctl(epoll_, EPOLL_CTL_MOD, source->fd, &event);
+                }
+                done_.notify_all();
+            }
+        }
+    }
+
+    void remove(std::uint64_t id)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto found = sources_.find(id);
+        if (found == sources_.end())
+        {
+            return;
+        }
+        auto source = found->second;
+        sources_.erase(found);
+        (void)::epoll_ctl(epoll_, EPOLL_CTL_DEL, source->fd, nullptr);
+        const auto self = std::this_thread::get_id();
+        done_.wait(lock, [&source, self] { return source->running == std::thread::id() || source->running == self; });
+    }
+
+    void close()
+    {
+        if (wakeup_ >= 0)
+        {
+            ::close(wakeup_);
+        }
+        ::close(epoll_);
+    }
+
+private:
+    int epoll_  = -1;
+    int wakeup_ = -1;
+    std::mutex mutex_;
+    std::condition_variable done_;
+    std::unordered_map<std::uint64_t, std::shared_ptr<Source>> sources_;
+    std::uint64_t lastId_ = 0; // 0 is the wakeup event
+    bool stop_            = false;
+    std::vector<std::thread> threads_;
+};
+
+/**
+ * @brief Pooler of elements read from a file descriptor watched by a reactor
+ *
+ * Usable as the Pooler of a Synchronizer, without a thread by source. When the file descriptor is
+ * readable, the reader is called until it returns null and its elements are notified from the
+ * thread of the reactor.
+ */
+template<class T>
+class FdPooler
+{
+public:
+    using Connection = typename Broadcaster<T>::Connection; ///< Notification connection
+    using Callback   = typename Broadcaster<T>::Callback;   ///< Callback for notification
+    /// @brief Reader of an element, returning null when nothing is left to read, e.g. on EAGAIN
+    using Reader = std::function<std::shared_ptr<T>(int fd)>;
+
+public:
+    /**
+     * @brief Constructor, starts watching the file descriptor
+     * @param reactor reactor watching the file descriptor, must outlive the pooler
+     * @param fd non-blocking file descriptor, owned by the caller, must stay open while the pooler lives
+     * @param reader reader of the elements
+     * @throws std::system_error if the file descriptor cannot be watched
+     */
+    FdPooler(Reactor& reactor, int fd, Reader reader) : impl_(std::make_unique<Impl>())
+    {
+        impl_->reader = std::move(reader);
+        auto read     = [impl = impl_.get(), fd](std::uint32_t)
+        {
+            while (auto data = impl->reader(fd))
+            {
+                impl->broadcaster.send(data);
+            }
+        };
+        impl_->registration = reactor.add(fd, EPOLLIN, std::move(read));
+    }
+
+    /**
+     * @brief Register notification callback
+     * @param cbk callback for notification, called from a thread of the reactor
+     * @returns Connection of the notification
+     */
+    Connection onReceived(Callback&& cbk) { return impl_->broadcaster.onReceived(std::move(cbk)); }
+
+private:
+    /// @brief State referenced by the handler, kept in place when the pooler is moved
+    struct Impl
+    {
+        Broadcaster<T> broadcaster;
+        Reader reader;
+        Reactor::Registration registration; // last, removed first
+    };
+
+private:
+    std::unique_ptr<Impl> impl_;
+};
+} // namespace synchro
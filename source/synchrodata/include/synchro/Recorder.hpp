@@ -0,0 +1,267 @@
+#pragma once
+
+#include "Synchronizer.hpp"
+#include "util/MappedFile.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace synchro
+{
+/**
+ * @brief Serialization of elements in a record log
+ *
+ * Defined for trivially copyable types, to be specialized for other types with:
+ * - static std::size_t size(const T&) returning the payload size
+ * - static void write(const T&, std::byte*) writing the payload
+ * - static std::shared_ptr<T> read(const std::byte*, std::size_t) reading a payload, null if the payload is invalid
+ */
+template<class T>
+struct Serializer
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Serializer must be specialized for types which are not trivially copyable");
+
+    /// @returns size of the payload of an element
+    static std::size_t size(const T&) { return sizeof(T); }
+    /// @brief Write the payload of an element
+    static void write(const T& data, std::byte* out) { std::memcpy(out, &data, sizeof(T)); }
+    /// @returns element read from its payload, null if its size is not the size of T
+    static std::shared_ptr<T> read(const std::byte* in, std::size_t size)
+    {
+        if (size != sizeof(T))
+        {
+            return nullptr;
+        }
+        auto data = std::make_shared<T>();
+        std::memcpy(data.get(), in, sizeof(T));
+        return data;
+    }
+};
+
+/// @brief Replay pacing
+enum class Pacing
+{
+    Original,        ///< elements are sent with their recorded intervals
+    AsFastAsPossible ///< elements are sent without waiting
+};
+
+namespace util
+{
+/// @brief Record log format
+struct RecordLog
+{
+    static constexpr std::uint64_t Magic = 0x31474f4c4e595300; ///< file signature
+
+    /// @brief File header
+    struct Header
+    {
+        std::uint64_t magic; ///< Magic
+        std::uint32_t types; ///< number of types of the recorder
+        std::uint32_t pad;   ///< reserved
+        std::uint64_t size;  ///< size of the complete records, the file may be longer if the recorder did not exit cleanly
+    };
+
+    /// @brief Record header, followed by the payload padded to 8 bytes
+    struct Record
+    {
+        std::uint32_t type;     ///< index of the type in required, optional then listed types
+        std::uint32_t size;     ///< payload size
+        std::int64_t timestamp; ///< steady clock time, nanoseconds
+    };
+
+    /// @returns size of a payload padded to 8 bytes
+    static constexpr std::size_t padded(std::size_t size) { return (size + 7) / 8 * 8; }
+};
+} // namespace util
+
+/**
+ * @brief Recorder of the elements sent to synchronized data
+ *
+ * Elements are appended with their type and time to a binary log written through a memory mapped
+ * file, to be replayed by a Replayer with the same types. Recording may be called from several
+ * threads, elements are logged in the order they are recorded.
+ *
+ * Requirements for R, O and L are the same as for SynchronizedData, Serializer<T> must be defined for
+ * each type.
+ */
+template<class R, class O = Optional<>, class L = List<>>
+class Recorder
+{
+public:
+    /**
+     * @brief Create a log
+     * @param path path of the log, truncated if it exists
+     * @throws std::system_error if the log cannot be created
+     */
+    explicit Recorder(const std::string& path) : file_(path)
+    {
+        auto* header = file_.append(sizeof(util::RecordLog::Header));
+        const util::RecordLog::Header value{util::RecordLog::Magic, std::tuple_size_v<AllTypes>, 0, sizeof(util::RecordLog::Header)};
+        std::memcpy(header, &value, sizeof(value));
+    }
+
+    /**
+     * @brief Record an element
+     *
+     * does nothing if element is not in the defined types
+     *
+     * @param data the element to record
+     */
+    template<class T>
+    void record(const std::shared_ptr<T>& data)
+    {
+        if constexpr (util::Contains<T, AllTypes>())
+        {
+            const auto timestamp   = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            const std::size_t size = Serializer<T>::size(*data);
+            const util::RecordLog::Record record{static_cast<std::uint32_t>(util::Index<T, AllTypes>::value), static_cast<std::uint32_t>(size), timestamp};
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto* bytes = file_.append(sizeof(record) + util::RecordLog::padded(size));
+            std::memcpy(bytes, &record, sizeof(record));
+            Serializer<T>::write(*data, bytes + sizeof(record));
+
+            // commit the record, the file is grown by chunks
+            const std::uint64_t committed = file_.size();
+            std::memcpy(file_.data() + offsetof(util::RecordLog::Header, size), &committed, sizeof(committed));
+        }
+    }
+
+    /**
+     * @brief Record all elements received by the poolers of a synchronizer
+     *
+     * The recorder must outlive the synchronizer, or connections must be disconnected.
+     *
+     * @param synchronizer synchronizer with the same types
+     * @returns connections to the poolers
+     */
+    template<template<class> class Pooler, class Policy>
+    std::vector<boost::signals2::connection> attach(Synchronizer<Pooler, R, O, L, Policy>& synchronizer)
+    {
+        std::vector<boost::signals2::connection> connections;
+        attach(synchronizer, connections, static_cast<AllTypes*>(nullptr));
+        return connections;
+    }
+
+    /// @returns size of the log
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return file_.size();
+    }
+
+private:
+    using AllTypes = typename util::Concat<typename R::TupleType, typename O::TupleType, typename L::TupleType>::type;
+
+    template<class S, class... Ts>
+    void attach(S& synchronizer, std::vector<boost::signals2::connection>& connections, std::tuple<Ts...>*)
+    {
+        (..., connections.push_back(synchronizer.template pooler<Ts>().onReceived([this](const std::shared_ptr<Ts>& data) { record(data); })));
+    }
+
+private:
+    mutable std::mutex mutex_;
+    util::AppendFile file_;
+};
+
+/**
+ * @brief Replayer of a log written by a Recorder
+ *
+ * Requirements for R, O and L are the same as for the Recorder of the log.
+ */
+template<class R, class O = Optional<>, class L = List<>>
+class Replayer
+{
+public:
+    /**
+     * @brief Open a log
+     * @param path path of the log
+     * @throws std::system_error if the log cannot be opened, std::runtime_error if it is not a log of these types
+     */
+    explicit Replayer(const std::string& path) : file_(path)
+    {
+        util::RecordLog::Header header{};
+        if (file_.size() < sizeof(header))
+        {
+            throw std::runtime_error("invalid record log " + path);
+        }
+        std::memcpy(&header, file_.data(), sizeof(header));
+        if (header.magic != util::RecordLog::Magic || header.types != std::tuple_size_v<AllTypes> || header.size < sizeof(header) || header.size > file_.size())
+        {
+            throw std::runtime_error("invalid record log " + path);
+        }
+        size_ = static_cast<std::size_t>(header.size);
+    }
+
+    /**
+     * @brief Send recorded elements
+     *
+     * @param target synchronized data, or any type with send functions, e.g. Synchronizer::data()
+     * @param pacing waiting between elements
+     * @returns number of sent elements
+     * @throws std::runtime_error if the log is corrupted, e.g. a payload is refused by its Serializer
+     */
+    template<class Target>
+    std::size_t replay(Target& target, Pacing pacing = Pacing::AsFastAsPossible) const
+    {
+        const auto start      = std::chrono::steady_clock::now();
+        std::int64_t first    = 0;
+        std::size_t count     = 0;
+        std::size_t offset    = sizeof(util::RecordLog::Header);
+        const std::byte* data = file_.data();
+        while (offset + sizeof(util::RecordLog::Record) <= size_)
+        {
+            util::RecordLog::Record record;
+            std::memcpy(&record, data + offset, sizeof(record));
+            offset += sizeof(record);
+            if (record.type >= std::tuple_size_v<AllTypes> || offset + record.size > size_)
+            {
+                throw std::runtime_error("corrupted record log");
+            }
+            if (pacing == Pacing::Original)
+            {
+                first = count == 0 ? record.timestamp : first;
+                std::this_thread::sleep_until(start + std::chrono::nanoseconds(record.timestamp - first));
+            }
+            send(target, record, data + offset, static_cast<AllTypes*>(nullptr));
+            offset += util::RecordLog::padded(record.size);
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    using AllTypes = typename util::Concat<typename R::TupleType, typename O::TupleType, typename L::TupleType>::type;
+
+    template<class Target, class... Ts>
+    static void send(Target& target, const util::RecordLog::Record& record, const std::byte* payload, std::tuple<Ts...>*)
+    {
+        std::uint32_t index = 0;
+        (void)(... || (index++ == record.type && (sendAs<Ts>(target, payload, record.size), true)));
+    }
+
+    template<class T, class Target>
+    static void sendAs(Target& target, const std::byte* payload, std::size_t size)
+    {
+        auto data = Serializer<T>::read(payload, size);
+        if (!data)
+        {
+            throw std::runtime_error("corrupted record log");
+        }
+        target.send(data);
+    }
+
+private:
+    util::ReadFile file_;
+    std::size_t size_ = 0; // committed size
+};
+} // namespace synchro
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "Broadcaster.hpp"
+#include "util/SharedMemory.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace synchro
+{
+namespace util
+{
+/**
+ * @brief Single producer ring of T in a shared memory segment
+ *
+ * Slots are consumed in order but may be released in any order: the producer stops at the first
+ * slot still in use. An all-zero segment is an empty ring, so that the producer and the consumer can
+ * create it in any order.
+ */
+template<class T>
+class ShmRing
+{
+    static_assert(std::is_trivially_copyable_v<T>, "shared memory elements must be trivially copyable");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared memory requires lock-free atomics");
+
+public:
+    /// @brief Slot state
+    enum State : std::uint32_t
+    {
+        Free    = 0, ///< writable by the producer
+        Written = 1, ///< published, not consumed yet
+        Reading = 2, ///< handed out by the consumer
+    };
+
+    /// @brief Slot with its state, on its own cache lines
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint32_t> state;            ///< State of the slot
+        alignas(T) unsigned char storage[sizeof(T)]; ///< Element storage
+
+        /// @returns element of the slot
+        T* get() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    /**
+     * @brief Open or create a ring
+     *
+     * @param name name of the shared memory segment, starting with '/'
+     * @param capacity number of slots, must be the same for all users of the ring
+     * @throws std::invalid_argument if the capacity is 0
+     * @throws std::system_error if the segment cannot be mapped or was created with another layout
+     */
+    ShmRing(const std::string& name, std::size_t capacity)
+        : memory_(name, sizeof(Header) + checkCapacity(capacity) * sizeof(Slot)),
+          header_(static_cast<Header*>(memory_.data())),
+          slots_(reinterpret_cast<Slot*>(header_ + 1))
+    {
+        checkLayout(header_->capacity, capacity, name);
+        checkLayout(header_->slotSize, sizeof(Slot), name);
+    }
+
+    /// @returns number of slots
+    std::size_t capacity() const { return static_cast<std::size_t>(header_->capacity.load(std::memory_order_relaxed)); }
+
+    /// @returns producer position
+    std::atomic<std::uint64_t>& head() { return header_->head; }
+    /// @returns consumer position
+    std::atomic<std::uint64_t>& tail() { return header_->tail; }
+    /// @returns slot of a position
+    Slot& slot(std::uint64_t position) { return slots_[position % capacity()]; }
+
+private:
+    struct alignas(64) Header
+    {
+        std::atomic<std::uint64_t> capacity;
+        std::atomic<std::uint64_t> slotSize;
+        alignas(64) std::atomic<std::uint64_t> head;
+        alignas(64) std::atomic<std::uint64_t> tail;
+    };
+
+    static std::size_t checkCapacity(std::size_t capacity)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("shm ring capacity must be at least 1");
+        }
+        return capacity;
+    }
+
+    // first user defines the layout, others must agree
+    static void checkLayout(std::atomic<std::uint64_t>& field, std::uint64_t value, const std::string& name)
+    {
+        std::uint64_t expected = 0;
+        if (!field.compare_exchange_strong(expected, value) && expected != value)
+        {
+            throw std::system_error(EINVAL, std::generic_category(), "shm layout " + name);
+        }
+    }
+
+private:
+    SharedMemory memory_;
+    Header* header_;
+    Slot* slots_;
+};
+} // namespace util
+
+/**
+ * @brief Producer of a shared memory ring, see ShmPooler
+ *
+ * There must be at most one producer by ring.
+ */
+template<class T>
+class ShmProducer
+{
+public:
+    /**
+     * @brief Open or create a ring
+     * @param name name of the shared memory segment, starting with '/'
+     * @param capacity number of slots
+     * @throws std::invalid_argument if the capacity is 0
+     */
+    ShmProducer(const std::string& name, std::size_t capacity) : ring_(std::make_shared<util::ShmRing<T>>(name, capacity)) {}
+
+    /**
+     * @brief Write an element directly in the next slot
+     *
+     * @param fill function with prototype void(T&) writing the element
+     * @returns false if the ring is full, fill is not called
+     */
+    template<class F>
+    bool tryEmplace(F&& fill)
+    {
+        auto& head = ring_->head();
+        const auto position = head.load(std::memory_order_relaxed);
+        auto& slot = ring_->slot(position);
+        if (slot.state.load(std::memory_order_acquire) != util::ShmRing<T>::Free)
+        {
+            return false;
+        }
+        fill(*new (slot.storage) T);
+        slot.state.store(util::ShmRing<T>::Written, std::memory_order_release);
+        head.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Copy an element in the next slot
+     * @param data element to publish
+     * @returns false if the ring is full
+     */
+    bool tryPush(const T& data)
+    {
+        return tryEmplace([&data](T& slot) { slot = data; });
+    }
+
+private:
+    std::shared_ptr<util::ShmRing<T>> ring_;
+};
+
+/**
+ * @brief Pooler of elements written by another process in shared memory
+ *
+ * Elements are read from a ring written by a ShmProducer, possibly in another process, and
+ * notified without copy: the notified pointer refers to the slot in shared memory, which is given
+ * back to the producer when the last copy of the pointer is released. Holding elements therefore
+ * holds slots, and the producer stalls once all slots are held.
+ *
+ * Elements are notified from the thread calling poll. T must be trivially copyable and must not
+ * hold pointers, as the segment is mapped at different addresses in each process.
+ *
+ * Segments persist when processes exit, call remove before a new session so that slots held by a
+ * previous process are not reused.
+ */
+template<class T>
+class ShmPooler
+{
+public:
+    using Connection = typename Broadcaster<T>::Connection; ///< Notification connection
+    using Callback   = typename Broadcaster<T>::Callback;   ///< Callback for notification
+
+public:
+    /**
+     * @brief Open or create a ring
+     * @param name name of the shared memory segment, starting with '/'
+     * @param capacity number of slots, must be the same as the producer one
+     * @throws std::invalid_argument if the capacity is 0
+     */
+    ShmPooler(const std::string& name, std::size_t capacity) : ring_(std::make_shared<util::ShmRing<T>>(name, capacity)) {}
+
+    /**
+     * @brief Register notification callback
+     * @param cbk callback for notification
+     * @returns Connection of the notification
+     */
+    Connection onReceived(Callback&& cbk) { return broadcaster_.onReceived(std::move(cbk)); }
+
+    /**
+     * @brief Notify elements written by the producer
+     * @param max maximal number of elements to notify
+     * @returns number of notified elements
+     */
+    std::size_t poll(std::size_t max = std::numeric_limits<std::size_t>::max())
+    {
+        auto& tail = ring_->tail();
+        std::size_t count = 0;
+        for (; count < max; ++count)
+        {
+            const auto position = tail.load(std::memory_order_relaxed);
+            auto& slot = ring_->slot(position);
+            if (slot.state.load(std::memory_order_acquire) != util::ShmRing<T>::Written)
+            {
+                break;
+            }
+            slot.state.store(util::ShmRing<T>::Reading, std::memory_order_relaxed);
+            tail.store(position + 1, std::memory_order_relaxed);
+            broadcaster_.send(std::shared_ptr<T>(slot.get(), Release{ring_, &slot}));
+        }
+        return count;
+    }
+
+    /**
+     * @brief Remove a shared memory segment
+     * @param name name of the segment
+     * @returns true if the segment existed
+     */
+    static bool remove(const std::string& name) { return util::SharedMemory::remove(name); }
+
+private:
+    /// @brief Deleter giving the slot back to the producer, keeps the mapping alive
+    struct Release
+    {
+        void operator()(T*) const { slot->state.store(util::ShmRing<T>::Free, std::memory_order_release); }
+
+        std::shared_ptr<util::ShmRing<T>> ring;
+        typename util::ShmRing<T>::Slot* slot;
+    };
+
+private:
+    std::shared_ptr<util::ShmRing<T>> ring_;
+    Broadcaster<T> broadcaster_;
+};
+} // namespace synchro
@@ -1,13 +1,31 @@
 #pragma once
 
-#include "Broadcaster.hpp"
+#include "Latest.hpp"
+#include "Mailbox.hpp"
+#include "Policy.hpp"
+#include "TimerWheel.hpp"
+#include "Trace.hpp"
+#include "util/PresenceMask.hpp"
+#include "util/RingBuffer.hpp"
+#include "util/Span.hpp"
 #include "util/SynchroUtils.hpp"
 
+#include <boost/signals2.hpp>
+
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 namespace synchro
 {
@@ -31,6 +49,193 @@ using Optional = TupleWrapper<Ts...>;
 template<class... Ts>
 using List = TupleWrapper<Ts...>;
 
+/// @brief Behaviour when a pending list is full
+enum class OverflowPolicy
+{
+    DropOldest, ///< the oldest pending element is dropped
+    DropNewest, ///< the element being sent is dropped
+    Block       ///< send blocks until pending elements are sent or discarded from another thread
+};
+
+/// @brief Behaviour when the deadline of an incomplete set expires
+enum class DeadlineAction
+{
+    Emit,   ///< pending elements are notified as a partial set, following elements are then notified immediately
+    Discard ///< pending elements are dropped, waiting again for a full set
+};
+
+/**
+ * @brief Aggregation of listed elements delivered in batches, see SynchronizedData::onBatch
+ *
+ * Windows are checked when elements arrive, there is no timer: a batch is delivered with the first
+ * element arriving after the window is over, and the batch of an idle stream is held until then.
+ */
+struct BatchMode
+{
+    /// @brief Flush condition
+    enum class Kind
+    {
+        Count,  ///< every count elements
+        Window, ///< every time window, from the first element of the batch
+        OnSet   ///< at each completion of the required set
+    };
+
+    Kind kind                       = Kind::OnSet;                 ///< flush condition
+    std::size_t count               = 0;                           ///< elements by batch, with Kind::Count
+    std::chrono::nanoseconds window = std::chrono::nanoseconds(0); ///< time window, with Kind::Window
+
+    /// @returns mode flushing every count elements
+    static BatchMode everyCount(std::size_t count) { return {Kind::Count, count, std::chrono::nanoseconds(0)}; }
+    /// @returns mode flushing every time window
+    static BatchMode everyWindow(std::chrono::nanoseconds window) { return {Kind::Window, 0, window}; }
+    /// @returns mode flushing at each completion of the required set
+    static BatchMode onSet() { return {Kind::OnSet, 0, std::chrono::nanoseconds(0)}; }
+};
+
+/**
+ * @brief Trait class to define default pending list settings of a listed type
+ *
+ * Specialize it to change the compile time settings of a type.
+ */
+template<class T>
+struct ListTraits
+{
+    static constexpr std::size_t capacity    = 256;                        ///< maximal number of pending elements
+    static constexpr OverflowPolicy overflow = OverflowPolicy::DropOldest; ///< behaviour when full
+};
+
+/**
+ * @brief View over a full synchronized set, only valid during the notification
+ *
+ * Holds the element of each required type, the element of each optional type received with the set
+ * (null if none) and the elements of each listed type received with the set. Elements are read in
+ * place from the synchronized data, without copy: sending to the same synchronized data during the
+ * notification would modify the set, hence set callbacks must not do it.
+ */
+template<class R, class O, class L>
+struct SynchronizedSet;
+/// @brief Specialization for tuple wrappers
+template<class... Rs, class... Os, class... Ls>
+struct SynchronizedSet<TupleWrapper<Rs...>, TupleWrapper<Os...>, TupleWrapper<Ls...>>
+{
+    const std::tuple<std::shared_ptr<Rs>...>& required;          ///< required elements, null only in a partial set on deadline
+    const std::tuple<std::shared_ptr<Os>...>& optional;          ///< optional elements, null if not received
+    std::tuple<util::Span<const std::shared_ptr<Ls>>...> lists; ///< listed elements, from oldest to newest
+
+    /**
+     * @brief Retrieve a required or optional element
+     * @returns the element of type T
+     */
+    template<class T>
+    const std::shared_ptr<T>& get() const
+    {
+        static_assert(util::Contains<T, std::tuple<Rs...>>() || util::Contains<T, std::tuple<Os...>>());
+        if constexpr (util::Contains<T, std::tuple<Rs...>>())
+        {
+            return std::get<std::shared_ptr<T>>(required);
+        }
+        else
+        {
+            return std::get<std::shared_ptr<T>>(optional);
+        }
+    }
+
+    /**
+     * @brief Retrieve listed elements
+     * @returns the elements of type T
+     */
+    template<class T>
+    util::Span<const std::shared_ptr<T>> list() const
+    {
+        return std::get<util::Span<const std::shared_ptr<T>>>(lists);
+    }
+};
+
+/**
+ * @brief Synchronized set owning its elements
+ *
+ * Same accessors as SynchronizedSet, holding copies of the elements of a set.
+ */
+template<class R, class O, class L>
+struct OwnedSet;
+/// @brief Specialization for tuple wrappers
+template<class... Rs, class... Os, class... Ls>
+struct OwnedSet<TupleWrapper<Rs...>, TupleWrapper<Os...>, TupleWrapper<Ls...>>
+{
+    std::tuple<std::shared_ptr<Rs>...> required;          ///< required elements, never null
+    std::tuple<std::shared_ptr<Os>...> optional;          ///< optional elements, null if not received
+    std::tuple<std::vector<std::shared_ptr<Ls>>...> lists; ///< listed elements, from oldest to newest
+
+    /**
+     * @brief Retrieve a required or optional element
+     * @returns the element of type T
+     */
+    template<class T>
+    const std::shared_ptr<T>& get() const
+    {
+        static_assert(util::Contains<T, std::tuple<Rs...>>() || util::Contains<T, std::tuple<Os...>>());
+        if constexpr (util::Contains<T, std::tuple<Rs...>>())
+        {
+            return std::get<std::shared_ptr<T>>(required);
+        }
+        else
+        {
+            return std::get<std::shared_ptr<T>>(optional);
+        }
+    }
+
+    /**
+     * @brief Retrieve listed elements
+     * @returns the elements of type T
+     */
+    template<class T>
+    util::Span<const std::shared_ptr<T>> list() const
+    {
+        const auto& elements = std::get<std::vector<std::shared_ptr<T>>>(lists);
+        return {elements.data(), elements.size()};
+    }
+
+    /// @brief Replace by a set, keeping list storage
+    template<class Set>
+    void assign(const Set& set)
+    {
+        required = set.required;
+        optional = set.optional;
+        (..., assignList<Ls>(set, true));
+    }
+
+    /// @brief Merge a newer set: last required and optional elements, all listed elements
+    template<class Set>
+    void merge(const Set& set)
+    {
+        required = set.required;
+        (..., mergeOptional<Os>(set));
+        (..., assignList<Ls>(set, false));
+    }
+
+private:
+    template<class T, class Set>
+    void mergeOptional(const Set& set)
+    {
+        if (const auto& element = std::get<std::shared_ptr<T>>(set.optional))
+        {
+            std::get<std::shared_ptr<T>>(optional) = element;
+        }
+    }
+
+    template<class T, class Set>
+    void assignList(const Set& set, bool replace)
+    {
+        auto& elements = std::get<std::vector<std::shared_ptr<T>>>(lists);
+        if (replace)
+        {
+            elements.clear();
+        }
+        const auto received = set.template list<T>();
+        elements.insert(elements.end(), received.begin(), received.end());
+    }
+};
+
 /**
  * @brief Synchronized data
  *
@@ -46,15 +251,44 @@ using List = TupleWrapper<Ts...>;
  * synchronization is achieved, only the last one will be sent.
  * - L : listed types (based on @a List trait). Synchronized data contains n elements by listed
  * type. No notification is sent unless at least one required data of each type is received. A
- * notification will be sent for each element of each list type.
+ * notification will be sent for each element of each list type. Pending elements are kept in a
+ * bounded ring whose capacity and overflow policy are set by ListTraits or configureList.
+ * - Policy : implementation choices (see DefaultPolicy), e.g. FastPolicy for lock-free notifications.
+ *
+ * Besides notifications by element, a single notification by synchronized set can be registered
+ * with onSynchronized. The first set is sent when synchronization is achieved; afterwards a set is
+ * sent on each required element, holding the last element of each other required type and the
+ * optional and listed elements received since the previous set. It is sent before notifications
+ * by element. With a policy publishing sets, e.g. LatestPolicy, the latest set may also be polled
+ * from any thread with latest.
+ *
+ * setDeadline bounds the time elements are held while a required type is missing, see DeadlineAction.
+ *
+ * send is called from a single thread, unless a listed type uses OverflowPolicy::Block: sends may
+ * then come from several threads and are serialized by a lock, held while callbacks are called, so
+ * that callbacks must not send to the same synchronized data.
  */
-template<class R, class O = Optional<>, class L = List<>>
+template<class R, class O = Optional<>, class L = List<>, class Policy = DefaultPolicy>
 class SynchronizedData
 {
 public:
+    /// @brief Broadcaster type by element, as defined by the policy
+    template<class T>
+    using Sender = typename Policy::template Broadcaster<T>;
+
     /// @brief Connection type by element
     template<class T>
-    using Connection = typename Broadcaster<T>::Connection;
+    using Connection = typename Sender<T>::Connection;
+
+    using Set           = SynchronizedSet<R, O, L>;        ///< Synchronized set view type
+    using SetCallback   = std::function<void(const Set&)>; ///< Callback for synchronized set notification
+    using SetConnection = boost::signals2::connection;     ///< Synchronized set notification connection
+
+    /// @brief Publication of the latest set, as defined by the policy
+    using Latest = typename Policy::template Latest<OwnedSet<R, O, L>>;
+
+    /// @brief Metrics type, as defined by the policy
+    using Metrics = typename Policy::template Metrics<typename util::Concat<typename R::TupleType, typename O::TupleType, typename L::TupleType>::type>;
 
 public:
     /**
@@ -64,23 +298,83 @@ public:
      * @returns broadcaster connection to store
      */
     template<class T>
-    Connection<T> onReceived(typename Broadcaster<T>::Callback&& cbk)
+    Connection<T> onReceived(typename Sender<T>::Callback&& cbk)
     {
         if constexpr (util::Contains<T, typename R::TupleType>())
         {
-            return std::get<Broadcaster<T>>(requiredBroadcasters_).onReceived(std::forward<typename Broadcaster<T>::Callback>(cbk));
+            return std::get<Sender<T>>(requiredBroadcasters_).onReceived(std::forward<typename Sender<T>::Callback>(cbk));
         }
         else if constexpr (util::Contains<T, typename O::TupleType>())
         {
-            return std::get<Broadcaster<T>>(optionalBroadcasters_).onReceived(std::forward<typename Broadcaster<T>::Callback>(cbk));
+            return std::get<Sender<T>>(optionalBroadcasters_).onReceived(std::forward<typename Sender<T>::Callback>(cbk));
         }
         else if constexpr (util::Contains<T, typename L::TupleType>())
         {
-            return std::get<Broadcaster<T>>(listBroadcasters_).onReceived(std::forward<typename Broadcaster<T>::Callback>(cbk));
+            return std::get<Sender<T>>(listBroadcasters_).onReceived(std::forward<typename Sender<T>::Callback>(cbk));
         }
         return Connection<T>();
     }
 
+    /**
+     * @brief Register callback for type T run by an executor
+     *
+     * Notifications of the callback are run in order on the executor, see bindExecutor.
+     *
+     * @param cbk callback with prototype void(const std::shared_ptr<T>&) to received notification
+     * @param executor executor running the callback
+     * @returns broadcaster connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(typename Sender<T>::Callback&& cbk, const Executor& executor)
+    {
+        return onReceived<T>(bindExecutor<T>(std::forward<typename Sender<T>::Callback>(cbk), executor));
+    }
+
+    /**
+     * @brief Register callback for type T behind its own mailbox
+     *
+     * A slow callback does not slow down sending nor the other callbacks, see Mailbox. MailboxMode::Conflate
+     * suits optional types, where only the newest element matters.
+     *
+     * @param cbk callback with prototype void(const std::shared_ptr<T>&) to received notification
+     * @param executor executor running the callback
+     * @param mode behaviour when the callback is slower than sending
+     * @param capacity ring capacity with MailboxMode::Block
+     * @returns broadcaster connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(typename Sender<T>::Callback&& cbk, const Executor& executor, MailboxMode mode, std::size_t capacity = Mailbox<T>::DefaultCapacity)
+    {
+        return onReceived<T>(bindMailbox<T>(std::forward<typename Sender<T>::Callback>(cbk), executor, mode, capacity));
+    }
+
+    /**
+     * @brief Register callback for full synchronized sets
+     *
+     * Sets are only built while callbacks are connected; the callback must not send to this
+     * synchronized data, see SynchronizedSet.
+     *
+     * @param cbk callback with prototype void(const Set&), the set is only valid during the call
+     * @returns connection to store
+     */
+    SetConnection onSynchronized(SetCallback&& cbk)
+    {
+        auto connection = setSignal_.connect(std::move(cbk));
+        setSubscribed_  = true; // after connecting, see sendSynchronized
+        return connection;
+    }
+
+    /**
+     * @brief Set the handler of full synchronized sets, called before the onSynchronized callbacks
+     *
+     * Unlike onSynchronized, the handler is a single function called directly, without signal, for
+     * owners chaining synchronized data, e.g. Pipeline. It must be set before elements are sent, and
+     * must not send to this synchronized data, see SynchronizedSet.
+     *
+     * @param handler handler with prototype void(const Set&), the set is only valid during the call, null to remove it
+     */
+    void setSynchronizedHandler(SetCallback handler) { setHandler_ = std::move(handler); }
+
     /**
      * @brief Send a data element
      *
@@ -91,53 +385,248 @@ public:
     template<class T>
     void send(const std::shared_ptr<T>& data)
     {
+        std::unique_lock<std::mutex> lock(sendMutex_, std::defer_lock);
+        if (blocking_)
+        {
+            lock.lock();
+        }
+        SYNCHRO_TRACE(Arrival, T);
         if constexpr (util::Contains<T, typename R::TupleType>())
         {
-            std::get<std::shared_ptr<T>>(requiredPendingData_) = data; // required for following test
-            if (initDone_ || areAllRequiredPresent())
+            metrics_.template received<T>();
+            // presence is the source of truth, slots are released when the set is cleared
+            if (requiredPresent_.set(util::Index<T, typename R::TupleType>::value))
+            {
+                metrics_.template overwritten<T>();
+            }
+            std::get<std::shared_ptr<T>>(requiredPendingData_) = data;
+            if (initDone_ || requiredPresent_.complete())
             {
-                std::get<Broadcaster<T>>(requiredBroadcasters_).send(data);
+                SYNCHRO_TRACE(SetComplete, T);
+                if (deadline_ && !initDone_)
+                {
+                    disarmDeadline();
+                }
+                if (setsWanted())
+                {
+                    sendSynchronized();
+                }
+                dispatch(std::get<Sender<T>>(requiredBroadcasters_), data);
                 std::get<std::shared_ptr<T>>(requiredPendingData_).reset();
 
                 // send pending signals
-                sendSignalsRequired(requiredBroadcasters_, requiredPendingData_);
-                sendSignalsOptional(optionalBroadcasters_, optionalPendingData_);
-                sendSignalsList(listBroadcasters_, listPendingData_);
+                sendSignalsRequired();
+                sendSignalsOptional();
+                sendSignalsList();
+                flushBatchesOnSet();
 
                 // Clear
                 clearAlldata();
                 initDone_ = true;
+                return;
             }
+            SYNCHRO_TRACE(Pending, T);
+            metrics_.template pending<T>();
+            armDeadline();
         }
         else if constexpr (util::Contains<T, typename O::TupleType>())
         {
+            metrics_.template received<T>();
             if (initDone_)
             {
-                std::get<Broadcaster<T>>(optionalBroadcasters_).send(data);
-                return;
+                dispatch(std::get<Sender<T>>(optionalBroadcasters_), data);
+                if (!setsWanted())
+                {
+                    return;
+                }
+            }
+            else
+            {
+                if (std::get<std::shared_ptr<T>>(optionalPendingData_))
+                {
+                    metrics_.template overwritten<T>();
+                }
+                SYNCHRO_TRACE(Pending, T);
+                metrics_.template pending<T>();
+                armDeadline();
             }
             std::get<std::shared_ptr<T>>(optionalPendingData_) = data; // put in pending
         }
         else if constexpr (util::Contains<T, typename L::TupleType>())
         {
+            metrics_.template received<T>();
+            auto& list = std::get<PendingList<T>>(listPendingData_);
+            if (!initDone_ && list.overflow == OverflowPolicy::Block && list.ring.full())
+            {
+                // the lock is handed over until the set is sent or discarded, the element then follows the pending ones
+                space_.wait(lock, [this, &list] { return initDone_ || !list.ring.full(); });
+            }
             if (initDone_)
             {
-                std::get<Broadcaster<T>>(listBroadcasters_).send(data);
+                dispatch(std::get<Sender<T>>(listBroadcasters_), data);
+                aggregate(data);
+                if (setsWanted())
+                {
+                    list.keep(data); // already notified, only kept for the next set
+                }
                 return;
             }
-            std::get<std::list<std::shared_ptr<T>>>(listPendingData_).push_back(data); // put in pending
+            if (list.push(data)) // put in pending
+            {
+                metrics_.template dropped<T>();
+            }
+            SYNCHRO_TRACE(Pending, T);
+            metrics_.template pending<T>(list.size());
+            armDeadline();
+        }
+    }
+
+    /**
+     * @brief Register callback for batches of listed type T
+     *
+     * Listed elements are aggregated for each callback according to its own mode, from its
+     * registration, and each batch is delivered as a contiguous span in a single call. Elements are
+     * notified by batch in the same order as one by one, and only once synchronization is achieved.
+     * Callbacks must not send T elements; elements aggregated for a disconnected callback are released
+     * with the next T element.
+     *
+     * @param cbk callback with prototype void(util::Span<const std::shared_ptr<T>>), the span is only valid during the call
+     * @param mode aggregation of the elements
+     * @returns connection to store
+     */
+    template<class T>
+    SetConnection onBatch(std::function<void(util::Span<const std::shared_ptr<T>>)>&& cbk, BatchMode mode)
+    {
+        static_assert(util::Contains<T, typename L::TupleType>());
+        auto& subscription = std::get<Batch<T>>(batches_).subscriptions.emplace_back(mode);
+        if (mode.kind == BatchMode::Kind::Count)
+        {
+            subscription.elements.reserve(mode.count);
+        }
+        return subscription.signal.connect(std::move(cbk));
+    }
+
+    /**
+     * @brief Change pending list settings of listed type T, must not be called concurrently with send
+     *
+     * Pending elements of type T are dropped, and counted as such. OverflowPolicy::Block is only
+     * meaningful when the elements completing the required set are sent from another thread than T
+     * elements; otherwise send blocks forever on overflow. A deadline is then expired by an executor,
+     * as its action takes the lock of the senders.
+     *
+     * @param capacity maximal number of pending elements
+     * @param overflow behaviour when full
+     * @throws std::invalid_argument for OverflowPolicy::Block with a capacity of 0, or with an inline deadline executor
+     */
+    template<class T>
+    void configureList(std::size_t capacity, OverflowPolicy overflow)
+    {
+        static_assert(util::Contains<T, typename L::TupleType>());
+        if (overflow == OverflowPolicy::Block && capacity == 0)
+        {
+            throw std::invalid_argument("OverflowPolicy::Block requires a capacity of at least 1");
+        }
+        if (overflow == OverflowPolicy::Block && deadline_ && deadline_->executor.isInline())
+        {
+            throw std::invalid_argument("OverflowPolicy::Block requires a deadline executor");
         }
+        std::get<PendingList<T>>(listPendingData_).configure(capacity, overflow);
+        blocking_ = std::apply([](const auto&... list) { return (false || ... || (list.overflow == OverflowPolicy::Block)); }, listPendingData_);
+    }
+
+    /**
+     * @brief Number of T elements dropped because the pending list was full
+     * @returns dropped elements count
+     */
+    template<class T>
+    std::size_t dropped() const
+    {
+        static_assert(util::Contains<T, typename L::TupleType>());
+        return std::get<PendingList<T>>(listPendingData_).dropped;
+    }
+
+    /**
+     * @brief Bound the time elements are held before synchronization
+     *
+     * The deadline is armed by the first pending element and cancelled when synchronization is
+     * achieved. On expiry, the action is posted to the executor, which must not run it concurrently
+     * with send: inline by default, i.e. from the thread advancing the wheel, which must then be the
+     * sending thread. A wheel advanced by its own thread (TimerWheel::start) requires an executor
+     * serialized with send, e.g. the strand or SerialExecutor of the senders; the wheel must not be
+     * started after a deadline with the inline executor is set. With OverflowPolicy::Block, senders
+     * are several threads and an executor is required as well. Synchronized data must outlive the
+     * wheel thread or the executor tasks.
+     *
+     * @param wheel timer wheel, shared by any number of synchronized data
+     * @param timeout maximal time elements are held
+     * @param action behaviour on expiry
+     * @param executor executor running the action
+     * @throws std::invalid_argument if the executor is inline and the wheel runs its own thread or a listed type blocks
+     */
+    void setDeadline(TimerWheel& wheel, TimerWheel::Clock::duration timeout, DeadlineAction action, Executor executor = Executor())
+    {
+        if (executor.isInline() && wheel.running())
+        {
+            throw std::invalid_argument("expiry would race with send: the deadline of a started wheel requires an executor");
+        }
+        if (executor.isInline() && blocking_)
+        {
+            // cancelling from a sender holding the lock would wait for an inline expiry waiting for the lock
+            throw std::invalid_argument("expiry would deadlock with blocked senders: OverflowPolicy::Block requires a deadline executor");
+        }
+        deadline_ = std::make_unique<Deadline>(*this, wheel, timeout, action, std::move(executor));
+    }
+
+    /// @brief Remove the deadline
+    void clearDeadline() { deadline_.reset(); }
+
+    /**
+     * @brief Retrieve metrics
+     *
+     * With SynchroMetrics (e.g. MetricsPolicy), snapshot() may be called from any thread.
+     *
+     * @returns metrics of the synchronized data
+     */
+    const Metrics& metrics() const { return metrics_; }
+
+    /**
+     * @brief Pin the latest synchronized set, may be called from any thread
+     *
+     * Requires a policy publishing sets, e.g. LatestPolicy. Polling is lock-free and does not block
+     * send; the set is read in place until the snapshot is destroyed, see LatestSet.
+     *
+     * @returns snapshot of the latest set, empty before synchronization
+     */
+    auto latest() const
+    {
+        static_assert(Latest::Enabled, "latest requires a policy publishing sets, e.g. LatestPolicy");
+        return latest_.read();
     }
 
     /// @brief Clear all broadcasters and pending data
     void clear()
     {
+        std::unique_lock<std::mutex> lock(sendMutex_, std::defer_lock);
+        if (blocking_)
+        {
+            lock.lock();
+        }
         clearAlldata();
         auto clear = [](auto&... broadcaster) { (..., broadcaster.clear()); };
         std::apply(clear, requiredBroadcasters_);
         std::apply(clear, optionalBroadcasters_);
         std::apply(clear, listBroadcasters_);
-        initDone_ = false;
+        setSignal_.disconnect_all_slots();
+        setHandler_ = nullptr;
+        std::apply([](auto&... batch) { (..., batch.clear()); }, batches_);
+        std::apply([](auto&... ptr) { (..., ptr.reset()); }, heldRequiredData_);
+        std::apply([](auto&... ptr) { (..., ptr.reset()); }, requiredPendingData_); // stale ones included
+        setSubscribed_ = false;
+        initDone_      = false;
+        if (deadline_)
+        {
+            disarmDeadline();
+        }
     }
 
 private:
@@ -148,7 +637,7 @@ private:
     template<class... Ts>
     struct Broadcasters<std::tuple<Ts...>>
     {
-        using type = std::tuple<Broadcaster<Ts>...>;
+        using type = std::tuple<Sender<Ts>...>;
     };
 
     /// @brief Data trait class to define tuple of elements
@@ -161,16 +650,137 @@ private:
         using type = std::tuple<std::shared_ptr<Ts>...>;
     };
 
+    /// @brief Bounded pending list of elements of a listed type
+    template<class T>
+    struct PendingList
+    {
+        // returns true if an element was dropped, the ring is not full with OverflowPolicy::Block
+        bool push(const std::shared_ptr<T>& data)
+        {
+            if (ring.full())
+            {
+                ++dropped;
+                if (overflow == OverflowPolicy::DropNewest || ring.empty())
+                {
+                    return true;
+                }
+                ring.pop();
+                ring.push(data);
+                return true;
+            }
+            ring.push(data);
+            return false;
+        }
+
+        // keeps an element already notified for the next set: never blocks nor counts as dropped
+        void keep(const std::shared_ptr<T>& data)
+        {
+            if (ring.full())
+            {
+                if (overflow == OverflowPolicy::DropNewest || ring.empty())
+                {
+                    return;
+                }
+                ring.pop(); // Block drops oldest: the sender must not wait for an element already delivered
+            }
+            ring.push(data);
+        }
+
+        std::size_t size() const { return ring.size(); }
+
+        std::optional<std::shared_ptr<T>> pop()
+        {
+            if (ring.empty())
+            {
+                return std::nullopt;
+            }
+            return ring.pop();
+        }
+
+        void clear() { ring.clear(); }
+
+        util::Span<const std::shared_ptr<T>> span()
+        {
+            auto elements = ring.linearize();
+            return util::Span<const std::shared_ptr<T>>(elements.data(), elements.size());
+        }
+
+        void configure(std::size_t size, OverflowPolicy policy)
+        {
+            dropped += ring.size();
+            ring     = util::RingBuffer<std::shared_ptr<T>>(size);
+            overflow = policy;
+        }
+
+        util::RingBuffer<std::shared_ptr<T>> ring{ListTraits<T>::capacity};
+        OverflowPolicy overflow    = ListTraits<T>::overflow;
+        std::atomic_size_t dropped = 0;
+    };
+
     /// @brief Data trait class to define tuple of lists of elements
     template<class T>
     struct DataList;
-    /// @brief Specialization to define a tuple of lists of shared pointers from a tuple
+    /// @brief Specialization to define a tuple of pending lists from a tuple
     template<class... Ts>
     struct DataList<std::tuple<Ts...>>
     {
-        template<class T>
-        using element = std::list<std::shared_ptr<T>>;
-        using type    = std::tuple<element<Ts>...>;
+        using type = std::tuple<PendingList<Ts>...>;
+    };
+
+    /// @brief Batches of listed elements being aggregated, one by batch callback
+    template<class T>
+    struct Batch
+    {
+        /// @brief Batch of a single callback
+        struct Subscription
+        {
+            using Element = std::shared_ptr<T>;
+
+            explicit Subscription(BatchMode m) : mode(m) {}
+
+            const BatchMode mode;
+            std::chrono::steady_clock::time_point start; // arrival of the first element, with BatchMode::Kind::Window
+            std::vector<Element> elements;
+            std::vector<Element> flushing; // swapped with elements while delivered, keeps both storages
+            boost::signals2::signal<void(util::Span<const Element>)> signal;
+        };
+
+        void clear() { subscriptions.clear(); }
+
+        std::list<Subscription> subscriptions; // stable, signals cannot be moved
+    };
+
+    /// @brief Batches trait class to define tuple of batches
+    template<class T>
+    struct Batches;
+    /// @brief Specialization to define a tuple of batches from a tuple
+    template<class... Ts>
+    struct Batches<std::tuple<Ts...>>
+    {
+        using type = std::tuple<Batch<Ts>...>;
+    };
+
+    /// @brief Deadline settings and timer
+    struct Deadline
+    {
+        Deadline(SynchronizedData& data, TimerWheel& w, TimerWheel::Clock::duration t, DeadlineAction a, Executor e)
+            : wheel(w), timeout(t), action(a), executor(std::move(e)), timer([this, &data] { post(data); })
+        {
+        }
+
+        // called from the thread advancing the wheel
+        void post(SynchronizedData& data)
+        {
+            const auto current = generation.load();
+            executor.post([&data, current] { data.expire(current); });
+        }
+
+        TimerWheel& wheel;
+        TimerWheel::Clock::duration timeout;
+        DeadlineAction action;
+        Executor executor;
+        std::atomic<std::uint64_t> generation{0}; // expiries posted with an older generation are ignored
+        TimerWheel::Timer timer;                  // last, cancelled before other members are destroyed
     };
 
     template<class T>
@@ -179,40 +789,219 @@ private:
     using DataTuple = typename Data<typename T::TupleType>::type;
     template<class T>
     using DataListTuple = typename DataList<typename T::TupleType>::type;
+    template<class T>
+    using BatchTuple = typename Batches<typename T::TupleType>::type;
+
+    template<class... Ts>
+    static constexpr bool blocks(std::tuple<Ts...>*)
+    {
+        return (false || ... || (ListTraits<Ts>::overflow == OverflowPolicy::Block));
+    }
+
+    template<class... Ts>
+    static constexpr bool blocksForever(std::tuple<Ts...>*)
+    {
+        return (false || ... || (ListTraits<Ts>::overflow == OverflowPolicy::Block && ListTraits<Ts>::capacity == 0));
+    }
+    static_assert(!blocksForever(static_cast<typename L::TupleType*>(nullptr)), "OverflowPolicy::Block requires a capacity of at least 1");
 
 private:
-    bool areAllRequiredPresent() const
+    template<class T>
+    void aggregate(const std::shared_ptr<T>& data)
     {
-        return std::apply([](auto&... ptr) { return (... && (ptr.use_count() > 0)); }, requiredPendingData_);
+        auto& subscriptions = std::get<Batch<T>>(batches_).subscriptions;
+        for (auto it = subscriptions.begin(); it != subscriptions.end();)
+        {
+            if (it->signal.empty())
+            {
+                it = subscriptions.erase(it); // disconnected, aggregated elements are released
+                continue;
+            }
+            aggregate(*it, data);
+            ++it;
+        }
+    }
+
+    template<class T>
+    static void aggregate(typename Batch<T>::Subscription& batch, const std::shared_ptr<T>& data)
+    {
+        if (batch.mode.kind == BatchMode::Kind::Window)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (batch.elements.empty())
+            {
+                batch.start = now;
+            }
+            batch.elements.push_back(data);
+            if (now - batch.start >= batch.mode.window)
+            {
+                flush(batch);
+            }
+            return;
+        }
+        batch.elements.push_back(data);
+        if (batch.mode.kind == BatchMode::Kind::Count && batch.elements.size() >= batch.mode.count)
+        {
+            flush(batch);
+        }
+    }
+
+    template<class Subscription>
+    static void flush(Subscription& batch)
+    {
+        std::swap(batch.elements, batch.flushing);
+        batch.signal(util::Span<const typename Subscription::Element>(batch.flushing.data(), batch.flushing.size()));
+        batch.flushing.clear();
+    }
+
+    template<class T>
+    static void flushOnSet(Batch<T>& batch)
+    {
+        for (auto& subscription : batch.subscriptions)
+        {
+            if (subscription.mode.kind == BatchMode::Kind::OnSet && !subscription.elements.empty())
+            {
+                flush(subscription);
+            }
+        }
+    }
+
+    void flushBatchesOnSet()
+    {
+        std::apply([](auto&... batch) { (..., flushOnSet(batch)); }, batches_);
+    }
+
+    // sets are built for set callbacks or latest set readers
+    bool setsWanted() const { return Latest::Enabled || setSubscribed_ || setHandler_; }
+
+    void armDeadline()
+    {
+        if (deadline_ && !deadline_->timer.scheduled())
+        {
+            deadline_->wheel.schedule(deadline_->timer, deadline_->timeout);
+        }
+    }
+
+    void disarmDeadline()
+    {
+        deadline_->wheel.cancel(deadline_->timer); // once cancelled, the timer cannot post the current generation anymore
+        ++deadline_->generation;
+    }
+
+    void expire(std::uint64_t generation)
+    {
+        std::unique_lock<std::mutex> lock(sendMutex_, std::defer_lock);
+        if (blocking_)
+        {
+            lock.lock();
+        }
+        if (!deadline_ || generation != deadline_->generation || initDone_)
+        {
+            return;
+        }
+        ++deadline_->generation;
+        if (deadline_->action == DeadlineAction::Emit)
+        {
+            // partial set, missing required elements are null
+            if (setsWanted())
+            {
+                sendSynchronized();
+            }
+            sendSignalsRequired();
+            sendSignalsOptional();
+            sendSignalsList();
+            flushBatchesOnSet();
+            initDone_ = true;
+        }
+        clearAlldata();
     }
 
     void clearAlldata()
     {
-        auto clear = [](auto&... ptr) { (..., ptr.reset()); };
-        std::apply(clear, requiredPendingData_);
-        std::apply(clear, optionalPendingData_);
+        // present slots are released, other slots are already empty
+        releaseRequired(std::make_index_sequence<std::tuple_size_v<DataTuple<R>>>());
+        requiredPresent_.reset();
+        std::apply([](auto&... ptr) { (..., ptr.reset()); }, optionalPendingData_);
         std::apply([](auto&... list) { (..., list.clear()); }, listPendingData_);
+        if (blocking_)
+        {
+            space_.notify_all(); // blocked senders resume once the lock is released
+        }
+    }
+
+    void sendSynchronized()
+    {
+        // hold last required elements, present ones are the new elements
+        holdRequired(std::make_index_sequence<std::tuple_size_v<DataTuple<R>>>());
+
+        auto lists = std::apply([](auto&... list) { return std::make_tuple(list.span()...); }, listPendingData_);
+        const Set set{heldRequiredData_, optionalPendingData_, lists};
+        if (setHandler_)
+        {
+            setHandler_(set);
+        }
+        if (setSubscribed_)
+        {
+            setSignal_(set);
+            if (setSignal_.empty())
+            {
+                // all callbacks disconnected, checked again for a callback connected meanwhile
+                setSubscribed_ = false;
+                if (!setSignal_.empty())
+                {
+                    setSubscribed_ = true;
+                }
+            }
+        }
+        latest_.publish(set);
+
+        if (initDone_)
+        {
+            // optional and listed elements were already notified one by one
+            std::apply([](auto&... ptr) { (..., ptr.reset()); }, optionalPendingData_);
+            std::apply([](auto&... list) { (..., list.clear()); }, listPendingData_);
+        }
     }
+
+    template<size_t... Is>
+    void holdRequired(std::index_sequence<Is...>)
+    {
+        (..., (requiredPresent_.test(Is) ? void(std::get<Is>(heldRequiredData_) = std::get<Is>(requiredPendingData_)) : void()));
+    }
+
+    template<size_t... Is>
+    void releaseRequired(std::index_sequence<Is...>)
+    {
+        (..., (requiredPresent_.test(Is) ? void(std::get<Is>(requiredPendingData_).reset()) : void()));
+    }
+
     template<class T>
-    static void sendSignal(Broadcaster<T>& sender, const std::shared_ptr<T>& data)
+    void sendSignal(Sender<T>& sender, const std::shared_ptr<T>& data)
     {
         if (data)
         {
-            sender.send(data);
+            metrics_.template synchronized<T>();
+            dispatch(sender, data);
         }
     }
 
-    template<class... Ts>
-    void sendSignalsRequired(std::tuple<Broadcaster<Ts>...>&, const std::tuple<std::shared_ptr<Ts>...>&)
+    template<class T>
+    void dispatch(Sender<T>& sender, const std::shared_ptr<T>& data)
     {
-        static_assert(std::tuple_size_v<std::tuple<Broadcaster<Ts>...>> == std::tuple_size_v<std::tuple<std::shared_ptr<Ts>...>>);
-        sendSignalsRequiredImpl<std::tuple_size_v<std::tuple<Broadcaster<Ts>...>>>();
+        const auto begin = metrics_.now();
+        sender.send(data);
+        metrics_.template dispatched<T>(begin);
     }
 
+    void sendSignalsRequired() { sendSignalsRequiredImpl<std::tuple_size_v<DataTuple<R>>>(); }
+
     template<size_t I, std::enable_if_t<(I > 0), bool> = true>
     void sendSignalsRequiredImpl()
     {
-        sendSignal(std::get<I - 1>(requiredBroadcasters_), std::get<I - 1>(requiredPendingData_));
+        if (requiredPresent_.test(I - 1))
+        {
+            sendSignal(std::get<I - 1>(requiredBroadcasters_), std::get<I - 1>(requiredPendingData_));
+        }
         sendSignalsRequiredImpl<I - 1>();
     }
 
@@ -221,12 +1010,7 @@ private:
     {
     }
 
-    template<class... Ts>
-    void sendSignalsOptional(std::tuple<Broadcaster<Ts>...>&, const std::tuple<std::shared_ptr<Ts>...>&)
-    {
-        static_assert(std::tuple_size_v<std::tuple<Broadcaster<Ts>...>> == std::tuple_size_v<std::tuple<std::shared_ptr<Ts>...>>);
-        sendSignalsOptionalImpl<std::tuple_size_v<std::tuple<Broadcaster<Ts>...>>>();
-    }
+    void sendSignalsOptional() { sendSignalsOptionalImpl<std::tuple_size_v<DataTuple<O>>>(); }
 
     template<size_t I, std::enable_if_t<(I > 0), bool> = true>
     void sendSignalsOptionalImpl()
@@ -240,19 +1024,16 @@ private:
     {
     }
 
-    template<class... Ts>
-    void sendSignalsList(std::tuple<Broadcaster<Ts>...>&, const std::tuple<std::list<std::shared_ptr<Ts>>...>&)
-    {
-        static_assert(std::tuple_size_v<std::tuple<Broadcaster<Ts>...>> == std::tuple_size_v<std::tuple<std::list<std::shared_ptr<Ts>>...>>);
-        sendSignalsListImpl<std::tuple_size_v<std::tuple<Broadcaster<Ts>...>>>();
-    }
+    void sendSignalsList() { sendSignalsListImpl<std::tuple_size_v<DataListTuple<L>>>(); }
 
     template<size_t I, std::enable_if_t<(I > 0), bool> = true>
     void sendSignalsListImpl()
     {
-        for (const auto& data : std::get<I - 1>(listPendingData_))
+        // pop one by one so that callbacks may send list elements, unless senders are serialized
+        while (auto data = std::get<I - 1>(listPendingData_).pop())
         {
-            sendSignal(std::get<I - 1>(listBroadcasters_), data);
+            sendSignal(std::get<I - 1>(listBroadcasters_), *data);
+            aggregate(*data);
         }
         sendSignalsListImpl<I - 1>();
     }
@@ -269,8 +1050,23 @@ private:
     BroadcastersTuple<L> listBroadcasters_;
 
     DataTuple<R> requiredPendingData_;
+    util::PresenceMask<std::tuple_size_v<typename R::TupleType>> requiredPresent_;
     DataTuple<O> optionalPendingData_;
     DataListTuple<L> listPendingData_;
+    BatchTuple<L> batches_;
+
+    std::atomic_bool setSubscribed_ = false;
+    boost::signals2::signal<void(const Set&)> setSignal_;
+    SetCallback setHandler_;
+    DataTuple<R> heldRequiredData_;
+
+    Metrics metrics_;
+    Latest latest_;
+    std::unique_ptr<Deadline> deadline_;
+
+    bool blocking_ = blocks(static_cast<typename L::TupleType*>(nullptr)); // a listed type blocks: sends are serialized
+    std::mutex sendMutex_;                                                 // only used when blocking
+    std::condition_variable space_;                                        // notified when pending lists are emptied, when blocking
 };
 
 } // namespace synchro
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SynchronizedData.hpp"
+#include "Trace.hpp"
 
 #include <vector>
 
@@ -9,15 +10,15 @@ namespace synchro
 /**
  * @brief Data synchronizer
  *
- * Requirements for R, O and L are the same as for SynchronizedData
+ * Requirements for R, O, L and Policy are the same as for SynchronizedData
  * Requirements for Pooler<T> are:
  * - function boost::signals2::connection onReceived(Callback&& cbk) where Callback is a function type with prototype void(const std::shared_ptr<T>&)
  */
-template<template<class> class Pooler, class R, class O = Optional<>, class L = List<>>
+template<template<class> class Pooler, class R, class O = Optional<>, class L = List<>, class Policy = DefaultPolicy>
 class Synchronizer
 {
 public:
-    using Data = SynchronizedData<R, O, L>; ///< Synchronized data type
+    using Data = SynchronizedData<R, O, L, Policy>; ///< Synchronized data type
 
     /// @brief Trait class to define tuple of Poolers
     template<class T>
@@ -89,7 +90,11 @@ private:
     void connect(Pooler<T>& pooler)
     {
         // redirect pooler on synchronized data
-        auto send       = [this](const std::shared_ptr<T>& data) { data_.send(data); };
+        auto send = [this](const std::shared_ptr<T>& data)
+        {
+            SYNCHRO_TRACE(Forward, T);
+            data_.send(data);
+        };
         auto connection = pooler.onReceived(send);
         connections_.push_back(connection);
     }
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "Executor.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace synchro
+{
+/**
+ * @brief Work-stealing thread pool
+ *
+ * Each worker owns a task deque. Tasks posted from a worker go to its own deque and are run last in,
+ * first out; other tasks are spread over workers. An idle worker steals the oldest tasks of the others
+ * before going to sleep. Tasks still queued at destruction are run before workers are joined.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Constructor, starts the workers
+     * @param threads number of workers
+     */
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency())
+    {
+        threads = threads > 0 ? threads : 1;
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            workers_.push_back(std::make_unique<Worker>());
+        }
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            threads_.emplace_back([this, i] { run(i); });
+        }
+    }
+
+    /// @brief Destructor, runs queued tasks then joins workers
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(idleMutex_);
+            stop_ = true;
+        }
+        idle_.notify_all();
+        for (auto& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Post a task
+     * @param task task to run on a worker
+     */
+    void post(Executor::Task&& task)
+    {
+        const auto& current     = currentWorker();
+        const std::size_t index = current.pool == this ? current.index : next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+        pending_.fetch_add(1); // counted first so that it never goes below the number of queued tasks
+        {
+            std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+            workers_[index]->tasks.push_back(std::move(task));
+        }
+        if (sleeping_.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(idleMutex_);
+            idle_.notify_one();
+        }
+    }
+
+    /// @returns executor posting tasks to the pool
+    Executor executor()
+    {
+        return Executor([this](Executor::Task&& task) { post(std::move(task)); });
+    }
+
+    /// @returns number of workers
+    std::size_t size() const { return workers_.size(); }
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Executor::Task> tasks;
+    };
+
+    struct Current
+    {
+        const ThreadPool* pool = nullptr;
+        std::size_t index      = 0;
+    };
+
+    static Current& currentWorker()
+    {
+        static thread_local Current current;
+        return current;
+    }
+
+private:
+    void run(std::size_t index)
+    {
+        currentWorker() = Current{this, index};
+        while (true)
+        {
+            if (auto task = take(index))
+            {
+                (*task)();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(idleMutex_);
+            sleeping_.fetch_add(1); // posters check it after counting their task
+            idle_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+            sleeping_.fetch_sub(1);
+            if (stop_ && pending_.load() == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    std::optional<Executor::Task> take(std::size_t index)
+    {
+        // own tasks first, newest first
+        {
+            auto& worker = *workers_[index];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.tasks.empty())
+            {
+                auto task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+                pending_.fetch_sub(1);
+                return task;
+            }
+        }
+        // then steal oldest tasks of others
+        for (std::size_t i = 1; i < workers_.size(); ++i)
+        {
+            auto& victim = *workers_[(index + i) % workers_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                auto task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pending_.fetch_sub(1);
+                return task;
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic_size_t next_     = 0;
+    std::atomic_size_t pending_  = 0;
+    std::atomic_size_t sleeping_ = 0;
+    std::mutex idleMutex_;
+    std::condition_variable idle_;
+    bool stop_ = false;
+};
+} // namespace synchro
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace synchro
+{
+/**
+ * @brief Hierarchical timer wheel shared by many timers
+ *
+ * Timers are intrusive: scheduling and cancelling link or unlink the timer in a slot of one of the
+ * wheels, in constant time and without allocation. The first wheel has one slot by tick, each next
+ * wheel one slot by revolution of the previous one; timers are moved down as time advances. Delays
+ * beyond the last wheel are clamped to its range (about 3 days with 1 ms ticks).
+ *
+ * Time is advanced by advance, from any thread, or by a thread owned by the wheel with start; calls
+ * to advance are serialized. Timer callbacks are called from the advancing thread, without the wheel
+ * being locked: they may schedule or cancel timers, but must not advance the wheel. Timers never
+ * expire early, and expire at most two ticks late when the wheel is advanced every tick.
+ */
+class TimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock; ///< Clock of the wheel
+
+    /// @brief Timer to schedule on a wheel
+    class Timer
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param callback function called on expiry
+         */
+        explicit Timer(std::function<void()> callback) : callback_(std::move(callback)) {}
+
+        /// @brief Destructor, cancels the timer if still scheduled or firing
+        ~Timer()
+        {
+            if (TimerWheel* wheel = wheel_.load(std::memory_order_acquire))
+            {
+                wheel->cancel(*this);
+            }
+        }
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        /// @returns true if the timer is scheduled and did not expire yet
+        bool scheduled() const { return scheduled_.load(std::memory_order_acquire); }
+
+    private:
+        friend class TimerWheel;
+
+        std::function<void()> callback_;
+        std::atomic<TimerWheel*> wheel_ = nullptr; // wheel the timer is scheduled or firing on
+        Timer* prev_                    = nullptr;
+        Timer* next_                    = nullptr;
+        Timer** slot_                   = nullptr; // head of the list the timer is linked in
+        std::uint64_t expiry_           = 0;       // in ticks
+        std::atomic_bool scheduled_     = false;
+    };
+
+public:
+    static constexpr std::size_t SlotBits = 6;                          ///< log2 of slots by wheel
+    static constexpr std::size_t Slots    = std::size_t(1) << SlotBits; ///< slots by wheel
+    static constexpr std::size_t Wheels   = 4;                          ///< number of wheels
+
+    /**
+     * @brief Constructor
+     * @param tick resolution of the wheel
+     */
+    explicit TimerWheel(Clock::duration tick = std::chrono::milliseconds(1)) : tick_(tick), origin_(Clock::now()) {}
+
+    /// @brief Destructor, stops the thread of the wheel if started
+    ~TimerWheel() { stop(); }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Schedule a timer, rescheduling it if already scheduled
+     * @param timer timer to schedule, must be cancelled or expired before the wheel is destroyed
+     * @param delay time before expiry
+     */
+    void schedule(Timer& timer, Clock::duration delay)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        unlink(timer);
+        // from the next tick after now, so that the timer never expires early even if time was not advanced lately
+        const auto ticks = (delay + tick_ - Clock::duration(1)) / tick_;
+        const auto now   = static_cast<std::uint64_t>((Clock::now() - origin_) / tick_);
+        timer.expiry_    = (now > current_ ? now : current_) + 1 + static_cast<std::uint64_t>(ticks > 0 ? ticks : 0);
+        timer.wheel_.store(this, std::memory_order_release);
+        link(timer);
+        timer.scheduled_.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Cancel a timer
+     *
+     * Once cancel returns, the timer callback is not running, unless cancel is called by the callback
+     * itself: the timer is then no longer accessed by the wheel, and may be destroyed by its callback.
+     *
+     * @param timer timer to cancel, does nothing if not scheduled
+     */
+    void cancel(Timer& timer)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        fired_.wait(lock, [this, &timer] { return firing_ != &timer || firingThread_ == std::this_thread::get_id(); });
+        if (firing_ == &timer)
+        {
+            firing_ = nullptr; // cancelled by its callback
+        }
+        unlink(timer);
+        timer.scheduled_.store(false, std::memory_order_release);
+        timer.wheel_.store(nullptr, std::memory_order_release);
+    }
+
+    /**
+     * @brief Advance time and call the callbacks of expired timers
+     *
+     * Waits for a concurrent advance, e.g. by the thread of the wheel, to complete.
+     *
+     * @param now current time
+     * @returns number of expired timers
+     */
+    std::size_t advance(Clock::time_point now = Clock::now())
+    {
+        std::lock_guard<std::mutex> serialized(advanceMutex_);
+        const auto target = static_cast<std::uint64_t>((now - origin_) / tick_);
+        std::size_t count = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (current_ < target)
+        {
+            ++current_;
+            cascade();
+            Timer*& slot = wheels_[0][current_ & (Slots - 1)];
+            while (Timer* timer = slot)
+            {
+                unlink(*timer);
+                timer->scheduled_.store(false, std::memory_order_release);
+                firing_       = timer;
+                firingThread_ = std::this_thread::get_id();
+                lock.unlock();
+                timer->callback_();
+                lock.lock();
+                if (firing_ == timer && !timer->slot_)
+                {
+                    timer->wheel_.store(nullptr, std::memory_order_release); // expired and not rescheduled
+                }
+                firing_ = nullptr;
+                fired_.notify_all();
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    /// @brief Start a thread advancing the wheel every tick
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        if (thread_.joinable())
+        {
+            return;
+        }
+        stop_   = false;
+        thread_ = std::thread(
+            [this]
+            {
+                std::unique_lock<std::mutex> lock(threadMutex_);
+                auto next = Clock::now();
+                while (!stop_)
+                {
+                    next += tick_;
+                    wakeup_.wait_until(lock, next, [this] { return stop_; });
+                    lock.unlock();
+                    advance();
+                    lock.lock();
+                }
+            });
+    }
+
+    /// @brief Stop the thread of the wheel
+    void stop()
+    {
+        std::unique_lock<std::mutex> lock(threadMutex_);
+        if (!thread_.joinable())
+        {
+            return;
+        }
+        stop_ = true;
+        wakeup_.notify_all();
+        lock.unlock();
+        thread_.join();
+    }
+
+    /// @returns true if the wheel is advanced by its own thread
+    bool running() const
+    {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        return thread_.joinable();
+    }
+
+    /// @returns resolution of the wheel
+    Clock::duration tick() const { return tick_; }
+
+private:
+    // must be called with mutex_ held
+    void link(Timer& timer)
+    {
+        const std::uint64_t delta = timer.expiry_ - current_;
+        std::size_t level         = 0;
+        while (level + 1 < Wheels && delta >= (std::uint64_t(1) << (SlotBits * (level + 1))))
+        {
+            ++level;
+        }
+        std::uint64_t expiry = timer.expiry_;
+        if (level + 1 == Wheels && delta >= (std::uint64_t(1) << (SlotBits * Wheels)))
+        {
+            expiry        = current_ + (std::uint64_t(1) << (SlotBits * Wheels)) - 1; // clamped
+            timer.expiry_ = expiry;
+        }
+        Timer*& head = wheels_[level][(expiry >> (SlotBits * level)) & (Slots - 1)];
+        timer.prev_  = nullptr;
+        timer.next_  = head;
+        if (head)
+        {
+            head->prev_ = &timer;
+        }
+        head        = &timer;
+        timer.slot_ = &head;
+    }
+
+    // must be called with mutex_ held
+    static void unlink(Timer& timer)
+    {
+        if (!timer.slot_)
+        {
+            return;
+        }
+        if (timer.prev_)
+        {
+            timer.prev_->next_ = timer.next_;
+        }
+        else
+        {
+            *timer.slot_ = timer.next_;
+        }
+        if (timer.next_)
+        {
+            timer.next_->prev_ = timer.prev_;
+        }
+        timer.prev_ = timer.next_ = nullptr;
+        timer.slot_ = nullptr;
+    }
+
+    // must be called with mutex_ held, moves timers of higher wheels reaching their last revolution
+    void cascade()
+    {
+        for (std::size_t level = 1; level < Wheels; ++level)
+        {
+            if ((current_ & ((std::uint64_t(1) << (SlotBits * level)) - 1)) != 0)
+            {
+                return;
+            }
+            Timer*& slot = wheels_[level][(current_ >> (SlotBits * level)) & (Slots - 1)];
+            Timer* timer = slot;
+            slot         = nullptr;
+            while (timer)
+            {
+                Timer* next  = timer->next_;
+                timer->slot_ = nullptr;
+                link(*timer);
+                timer = next;
+            }
+        }
+    }
+
+private:
+    const Clock::duration tick_;
+    const Clock::time_point origin_;
+    std::mutex advanceMutex_; // serializes advance
+    std::mutex mutex_;
+    std::condition_variable fired_;
+    std::array<std::array<Timer*, Slots>, Wheels> wheels_{};
+    std::uint64_t current_ = 0;
+    Timer* firing_         = nullptr;
+    std::thread::id firingThread_;
+
+    mutable std::mutex threadMutex_;
+    std::condition_variable wakeup_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+} // namespace synchro
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <boost/core/demangle.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+/**
+ * @brief Trace point of an event of type T, compiled out unless SYNCHRO_ENABLE_TRACING is defined
+ *
+ * SYNCHRO_ENABLE_TRACING is defined for all users of the library by the Synchro_ENABLE_TRACING CMake option.
+ */
+#ifdef SYNCHRO_ENABLE_TRACING
+#define SYNCHRO_TRACE(event, T) ::synchro::trace::record(::synchro::trace::Event::event, typeid(T).name())
+#else
+#define SYNCHRO_TRACE(event, T) ((void)0)
+#endif
+
+namespace synchro
+{
+namespace trace
+{
+/// @brief Traced event
+enum class Event : std::uint8_t
+{
+    Arrival,       ///< element received by synchronized data
+    Pending,       ///< element kept pending, waiting for a full set
+    SetComplete,   ///< element completing a set
+    DispatchBegin, ///< a callback of a type is being called
+    DispatchEnd,   ///< a callback of a type returned
+    Forward        ///< element forwarded by a synchronizer from its pooler
+};
+
+/// @brief Traced event of a thread
+struct Record
+{
+    std::int64_t time;    ///< steady clock, nanoseconds
+    const char* name;     ///< mangled name of the type
+    std::uint32_t thread; ///< index of the thread, unique in the process
+    Event event;          ///< event
+};
+
+/**
+ * @brief Buffer of the last events of a thread
+ *
+ * Written by its thread only, without lock nor read-modify-write: recording an event is a clock
+ * read and a few relaxed stores. Once full, the oldest events are overwritten; a snapshot skips the
+ * events overwritten while it is taken.
+ */
+class Buffer
+{
+public:
+    static constexpr std::size_t Capacity = std::size_t(1) << 14; ///< events kept by thread
+
+    /**
+     * @brief Give the buffer to a thread, from that thread
+     * @param thread index of the thread, recorded with its events
+     */
+    void lease(std::uint32_t thread) { thread_ = thread; }
+
+    /**
+     * @brief Record an event, from the thread of the buffer
+     * @param event traced event
+     * @param name mangled name of the type, with static storage duration
+     */
+    void record(Event event, const char* name)
+    {
+        const auto time           = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        const std::uint64_t count = count_.load(std::memory_order_relaxed);
+        writing_.store(count + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // a snapshot reading the new fields sees writing_
+
+        auto& slot = slots_[count & (Capacity - 1)];
+        slot.time.store(time, std::memory_order_relaxed);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.thread.store(thread_, std::memory_order_relaxed);
+        slot.event.store(event, std::memory_order_relaxed);
+        count_.store(count + 1, std::memory_order_release);
+    }
+
+    /// @returns recorded events since last clear, from oldest to newest
+    std::vector<Record> snapshot() const
+    {
+        const std::uint64_t count = count_.load(std::memory_order_acquire);
+        const std::uint64_t first = std::max(start_.load(std::memory_order_relaxed), count > Capacity ? count - Capacity : 0);
+        std::vector<Record> records;
+        records.reserve(count - first);
+        for (std::uint64_t i = first; i < count; ++i)
+        {
+            const auto& slot = slots_[i & (Capacity - 1)];
+            records.push_back(Record{slot.time.load(std::memory_order_relaxed), slot.name.load(std::memory_order_relaxed),
+                                     slot.thread.load(std::memory_order_relaxed), slot.event.load(std::memory_order_relaxed)});
+        }
+
+        // the last event written overwrites the slot of the event Capacity before it: older ones may be torn
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t writing = writing_.load(std::memory_order_relaxed);
+        if (writing > Capacity && writing - Capacity > first)
+        {
+            records.erase(records.begin(), records.begin() + static_cast<std::ptrdiff_t>(std::min(writing - Capacity, count) - first));
+        }
+        return records;
+    }
+
+    /// @brief Forget recorded events, may be called from any thread
+    void clear() { start_.store(count_.load(std::memory_order_acquire), std::memory_order_relaxed); }
+
+private:
+    /// @brief Record slot, read while it may be overwritten
+    struct Slot
+    {
+        std::atomic<std::int64_t> time;
+        std::atomic<const char*> name;
+        std::atomic<std::uint32_t> thread;
+        std::atomic<Event> event;
+    };
+
+    std::array<Slot, Capacity> slots_;
+    alignas(64) std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> writing_{0}; // count once the event being written is recorded
+    std::atomic<std::uint64_t> start_{0};   // first event after last clear
+    std::uint32_t thread_ = 0;              // index of the thread holding the buffer
+};
+
+/**
+ * @brief Registry of the buffers of all threads
+ *
+ * Buffers are kept once their thread exits, so that events can be exported after the threads
+ * are joined, and are reused by the next threads, keeping their events: the number of buffers is
+ * bounded by the number of threads tracing at once. Each thread gets its own index, in order of
+ * first event, recorded with its events and exported as their thread id.
+ */
+class Tracer
+{
+public:
+    /// @returns the tracer of the process
+    static Tracer& instance()
+    {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    /// @returns the buffer of the calling thread, acquired on first call, null once released by the exiting thread
+    static Buffer* local()
+    {
+        if (!local_.buffer && !local_.released)
+        {
+            thread_local const Lease lease(instance());
+        }
+        return local_.buffer;
+    }
+
+    /// @returns number of buffers, exited threads included
+    std::size_t buffers() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return buffers_.size();
+    }
+
+    /// @brief Forget recorded events of all threads
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& buffer : buffers_)
+        {
+            buffer->clear();
+        }
+    }
+
+    /**
+     * @brief Export recorded events as Chrome trace JSON, readable by chrome://tracing and Perfetto
+     *
+     * Dispatches are exported as slices, other events as instants; events being recorded while
+     * exporting may be missing or torn.
+     *
+     * @param out output stream
+     */
+    void exportChrome(std::ostream& out) const
+    {
+        std::vector<std::shared_ptr<Buffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffers = buffers_;
+        }
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        const char* separator = "";
+        for (const auto& buffer : buffers)
+        {
+            for (const auto& record : buffer->snapshot())
+            {
+                out << separator << "{\"name\":\"" << label(record.event);
+                if (record.event != Event::DispatchEnd)
+                {
+                    out << ' ';
+                    escape(out, boost::core::demangle(record.name));
+                }
+                out << "\",\"cat\":\"synchro\",\"ph\":\"" << phase(record.event) << "\",\"ts\":" << record.time / 1000 << '.';
+                out << digits(record.time % 1000).data() << ",\"pid\":1,\"tid\":" << record.thread;
+                if (phase(record.event) == 'i')
+                {
+                    out << ",\"s\":\"t\"";
+                }
+                out << '}';
+                separator = ",\n";
+            }
+        }
+        out << "]}\n";
+    }
+
+private:
+    /// @brief Buffer of the calling thread, trivially initialized and destroyed so that it remains valid while the thread exits
+    struct Local
+    {
+        Buffer* buffer;
+        bool released;
+    };
+
+    /// @brief Lease of a buffer by a thread, returned to the free list when the thread exits
+    struct Lease
+    {
+        explicit Lease(Tracer& owner) : tracer(owner) { local_.buffer = tracer.acquire(); }
+        ~Lease()
+        {
+            tracer.release(local_.buffer);
+            local_ = {nullptr, true};
+        }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Tracer& tracer;
+    };
+
+    Tracer() = default;
+
+    // called by the thread acquiring the buffer
+    Buffer* acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Buffer* buffer = nullptr;
+        if (!free_.empty())
+        {
+            buffer = free_.back();
+            free_.pop_back();
+        }
+        else
+        {
+            buffers_.push_back(std::make_shared<Buffer>());
+            buffer = buffers_.back().get();
+        }
+        buffer->lease(threads_++);
+        return buffer;
+    }
+
+    void release(Buffer* buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(buffer);
+    }
+
+    static const char* label(Event event)
+    {
+        switch (event)
+        {
+        case Event::Arrival:
+            return "arrival";
+        case Event::Pending:
+            return "pending";
+        case Event::SetComplete:
+            return "set complete";
+        case Event::DispatchBegin:
+        case Event::DispatchEnd:
+            return "dispatch";
+        case Event::Forward:
+            return "forward";
+        }
+        return "";
+    }
+
+    static char phase(Event event) { return event == Event::DispatchBegin ? 'B' : (event == Event::DispatchEnd ? 'E' : 'i'); }
+
+    // microseconds fraction, zero padded
+    static std::array<char, 4> digits(std::int64_t nanoseconds)
+    {
+        const auto value = static_cast<int>(nanoseconds < 0 ? -nanoseconds : nanoseconds);
+        return {static_cast<char>('0' + value / 100), static_cast<char>('0' + value / 10 % 10), static_cast<char>('0' + value % 10), '\0'};
+    }
+
+    static void escape(std::ostream& out, const std::string& name)
+    {
+        for (char c : name)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out << '\\';
+            }
+            out << c;
+        }
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<Buffer>> buffers_;
+    std::vector<Buffer*> free_;  // buffers of exited threads, reused first
+    std::uint32_t threads_ = 0; // indexes given to threads
+    static inline thread_local Local local_{nullptr, false};
+};
+
+/**
+ * @brief Record an event in the buffer of the calling thread, see SYNCHRO_TRACE
+ * @param event traced event
+ * @param name mangled name of the type, with static storage duration
+ */
+inline void record(Event event, const char* name)
+{
+    if (Buffer* buffer = Tracer::local()) // events of an exiting thread whose buffer was released are dropped
+    {
+        buffer->record(event, name);
+    }
+}
+} // namespace trace
+} // namespace synchro
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "Policy.hpp"
+#include "SynchronizedData.hpp"
+#include "Trace.hpp"
+#include "util/RingBuffer.hpp"
+
+#include <boost/signals2.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace synchro
+{
+/**
+ * @brief Lossless synchronized data pairing required elements in lockstep
+ *
+ * Whereas SynchronizedData keeps the last element of each required type, zip data queues every
+ * required element and sends a set each time all queues are non-empty, made of the oldest element of
+ * each type, like a zip of the streams: each element is sent exactly once, in a single set.
+ * - R : required types (based on @a Required trait).
+ * - Policy : same as for SynchronizedData.
+ *
+ * Queues are bounded by a high-water mark and allocated at construction. A type whose queue reached
+ * the high-water mark applies backpressure to its pooler: send blocks until a set is sent, and
+ * trySend refuses the element. Sending blocks forever if the elements completing the next set can
+ * only be sent from the blocked thread, e.g. when all types are sent from a single thread: trySend
+ * must then be used.
+ *
+ * Elements may be sent from several threads. Sets are sent in order, one at a time, by one of the
+ * sending threads; callbacks may trySend but must not send.
+ */
+template<class R, class Policy = DefaultPolicy>
+class ZipSynchronizedData;
+
+/// @brief Specialization for required types wrapper
+template<class... Rs, class Policy>
+class ZipSynchronizedData<Required<Rs...>, Policy>
+{
+    static_assert(sizeof...(Rs) > 0, "at least one required type must be zipped");
+
+public:
+    /// @brief Broadcaster type by element, as defined by the policy
+    template<class T>
+    using Sender = typename Policy::template Broadcaster<T>;
+
+    /// @brief Connection type by element
+    template<class T>
+    using Connection = typename Sender<T>::Connection;
+
+    using Set           = SynchronizedSet<Required<Rs...>, Optional<>, List<>>; ///< Synchronized set view type
+    using SetCallback   = std::function<void(const Set&)>;                      ///< Callback for synchronized set notification
+    using SetConnection = boost::signals2::connection;                          ///< Synchronized set notification connection
+
+    static constexpr std::size_t DefaultHighWaterMark = 64; ///< default maximal number of queued elements by type
+
+public:
+    /**
+     * @brief Constructor, allocates the queues
+     * @param highWaterMark maximal number of queued elements by type
+     * @throws std::invalid_argument if the high-water mark is 0
+     */
+    explicit ZipSynchronizedData(std::size_t highWaterMark = DefaultHighWaterMark) : highWaterMark_(highWaterMark), queues_(Queue<Rs>(highWaterMark)...)
+    {
+        if (highWaterMark == 0)
+        {
+            throw std::invalid_argument("high-water mark must be at least 1");
+        }
+    }
+
+    ZipSynchronizedData(const ZipSynchronizedData&) = delete;
+    ZipSynchronizedData& operator=(const ZipSynchronizedData&) = delete;
+
+    /**
+     * @brief Register callback for type T
+     *
+     * @param cbk callback with prototype void(const std::shared_ptr<T>&), called for each element of a set
+     * @returns broadcaster connection to store
+     */
+    template<class T>
+    Connection<T> onReceived(typename Sender<T>::Callback&& cbk)
+    {
+        static_assert(util::Contains<T, std::tuple<Rs...>>());
+        return std::get<Sender<T>>(broadcasters_).onReceived(std::forward<typename Sender<T>::Callback>(cbk));
+    }
+
+    /**
+     * @brief Register callback for synchronized sets, called before notifications by element
+     *
+     * @param cbk callback with prototype void(const Set&), the set is only valid during the call
+     * @returns connection to store
+     */
+    SetConnection onSynchronized(SetCallback&& cbk)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        setSubscribed_ = true;
+        return setSignal_.connect(std::move(cbk));
+    }
+
+    /**
+     * @brief Send an element, blocking while the queue of its type is at the high-water mark
+     *
+     * does nothing if element is not in the required types
+     *
+     * @param data the element to send
+     */
+    template<class T>
+    void send(const std::shared_ptr<T>& data)
+    {
+        if constexpr (util::Contains<T, std::tuple<Rs...>>())
+        {
+            push(data, true);
+        }
+    }
+
+    /**
+     * @brief Send an element unless the queue of its type is at the high-water mark
+     *
+     * @param data the element to send
+     * @returns false if the element was refused
+     */
+    template<class T>
+    bool trySend(const std::shared_ptr<T>& data)
+    {
+        static_assert(util::Contains<T, std::tuple<Rs...>>());
+        return push(data, false);
+    }
+
+    /// @returns number of queued elements of type T
+    template<class T>
+    std::size_t queued() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::get<Queue<T>>(queues_).size();
+    }
+
+    /// @returns maximal number of queued elements by type
+    std::size_t highWaterMark() const { return highWaterMark_; }
+
+    /// @brief Clear all broadcasters and queued elements, unblocking senders
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::apply([](auto&... queue) { (..., queue.clear()); }, queues_);
+        std::apply([](auto&... broadcaster) { (..., broadcaster.clear()); }, broadcasters_);
+        setSignal_.disconnect_all_slots();
+        setSubscribed_ = false;
+        space_.notify_all();
+    }
+
+private:
+    template<class T>
+    using Queue = util::RingBuffer<std::shared_ptr<T>>;
+
+    template<class T>
+    bool push(const std::shared_ptr<T>& data, bool wait)
+    {
+        SYNCHRO_TRACE(Arrival, T);
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto& queue = std::get<Queue<T>>(queues_);
+        if (queue.full())
+        {
+            if (!wait)
+            {
+                return false;
+            }
+            space_.wait(lock, [&queue] { return !queue.full(); });
+        }
+        queue.push(data);
+        if (!(... && !std::get<Queue<Rs>>(queues_).empty()))
+        {
+            SYNCHRO_TRACE(Pending, T);
+            return true;
+        }
+        SYNCHRO_TRACE(SetComplete, T);
+        if (!emitting_)
+        {
+            emit(lock);
+        }
+        return true;
+    }
+
+    // sends sets while complete, other threads only queue elements meanwhile
+    void emit(std::unique_lock<std::mutex>& lock)
+    {
+        emitting_ = true;
+        while ((... && !std::get<Queue<Rs>>(queues_).empty()))
+        {
+            // pop before sending so that blocked senders resume
+            const std::tuple<std::shared_ptr<Rs>...> required(std::get<Queue<Rs>>(queues_).pop()...);
+            const bool setSubscribed = setSubscribed_;
+            space_.notify_all();
+            lock.unlock();
+            if (setSubscribed)
+            {
+                setSignal_(Set{required, empty_, {}});
+            }
+            (..., std::get<Sender<Rs>>(broadcasters_).send(std::get<std::shared_ptr<Rs>>(required)));
+            lock.lock();
+        }
+        emitting_ = false;
+    }
+
+private:
+    const std::size_t highWaterMark_;
+    mutable std::mutex mutex_;
+    std::condition_variable space_; // notified when elements are popped
+    bool emitting_      = false;    // a thread is sending sets
+    bool setSubscribed_ = false;
+    std::tuple<Queue<Rs>...> queues_;
+    std::tuple<Sender<Rs>...> broadcasters_;
+    boost::signals2::signal<void(const Set&)> setSignal_;
+    const std::tuple<> empty_{};
+};
+} // namespace synchro
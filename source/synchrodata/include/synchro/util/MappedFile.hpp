@@ -0,0 +1,171 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+namespace synchro
+{
+namespace util
+{
+/**
+ * @brief File written through a memory mapping, append only
+ *
+ * The file is grown and remapped by chunks, so that appending is a copy in memory without system
+ * call in most cases. The file is truncated to the appended size on destruction: if the process
+ * does not exit cleanly, the file ends with zero bytes up to the end of the chunk.
+ */
+class AppendFile
+{
+public:
+    /**
+     * @brief Create or truncate a file
+     * @param path path of the file
+     * @param chunk size by which the file is grown
+     * @throws std::system_error if the file cannot be created or mapped
+     */
+    explicit AppendFile(const std::string& path, std::size_t chunk = std::size_t(1) << 20) : path_(path), chunk_(chunk)
+    {
+        fd_ = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+        if (fd_ < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        try
+        {
+            grow(chunk_);
+        }
+        catch (...)
+        {
+            ::close(fd_);
+            throw;
+        }
+    }
+
+    ~AppendFile()
+    {
+        ::munmap(data_, capacity_);
+        (void)::ftruncate(fd_, static_cast<off_t>(size_));
+        ::close(fd_);
+    }
+    AppendFile(const AppendFile&) = delete;
+    AppendFile& operator=(const AppendFile&) = delete;
+
+    /**
+     * @brief Reserve bytes at the end of the file
+     * @param size number of bytes
+     * @returns address of the bytes to write, valid until the next append
+     * @throws std::system_error if the file cannot be grown
+     */
+    std::byte* append(std::size_t size)
+    {
+        if (size_ + size > capacity_)
+        {
+            grow(((size_ + size) / chunk_ + 1) * chunk_);
+        }
+        std::byte* bytes = data_ + size_;
+        size_ += size;
+        return bytes;
+    }
+
+    /// @returns number of appended bytes
+    std::size_t size() const { return size_; }
+
+    /// @returns address of the first byte, valid until the next append
+    std::byte* data() { return data_; }
+
+private:
+    // the current mapping is kept until the new one succeeds, the file is only made longer
+    void grow(std::size_t capacity)
+    {
+        if (::ftruncate(fd_, static_cast<off_t>(capacity)) < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "ftruncate " + path_);
+        }
+        void* data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (data == MAP_FAILED)
+        {
+            throw std::system_error(errno, std::generic_category(), "mmap " + path_);
+        }
+        if (data_)
+        {
+            ::munmap(data_, capacity_);
+        }
+        data_     = static_cast<std::byte*>(data);
+        capacity_ = capacity;
+    }
+
+private:
+    std::string path_;
+    std::size_t chunk_;
+    int fd_               = -1;
+    std::byte* data_      = nullptr;
+    std::size_t size_     = 0;
+    std::size_t capacity_ = 0;
+};
+
+/// @brief File read through a memory mapping
+class ReadFile
+{
+public:
+    /**
+     * @brief Map a file
+     * @param path path of the file
+     * @throws std::system_error if the file cannot be opened or mapped
+     */
+    explicit ReadFile(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        struct stat status;
+        if (::fstat(fd, &status) < 0)
+        {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat " + path);
+        }
+        size_ = static_cast<std::size_t>(status.st_size);
+        if (size_ > 0)
+        {
+            void* data      = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            const int error = errno;
+            if (data == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "mmap " + path);
+            }
+            data_ = static_cast<const std::byte*>(data);
+        }
+        ::close(fd);
+    }
+
+    ~ReadFile()
+    {
+        if (data_)
+        {
+            ::munmap(const_cast<std::byte*>(data_), size_);
+        }
+    }
+    ReadFile(const ReadFile&) = delete;
+    ReadFile& operator=(const ReadFile&) = delete;
+
+    /// @returns content of the file
+    const std::byte* data() const { return data_; }
+    /// @returns size of the file
+    std::size_t size() const { return size_; }
+
+private:
+    const std::byte* data_ = nullptr;
+    std::size_t size_      = 0;
+};
+} // namespace util
+} // namespace synchro
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace synchro
+{
+namespace util
+{
+/**
+ * @brief Unbounded multi-producer single-consumer queue
+ *
+ * Node based queue (D. Vyukov): pushing is wait-free (one atomic exchange), so producers never wait
+ * on each other. Pop, empty and destruction must only be called from the single consumer.
+ */
+template<class T>
+class MpscQueue
+{
+public:
+    MpscQueue() : head_(new Node), tail_(head_.load()) {}
+    ~MpscQueue()
+    {
+        while (tail_)
+        {
+            Node* next = tail_->next.load(std::memory_order_relaxed);
+            delete tail_;
+            tail_ = next;
+        }
+    }
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Push an element, may be called concurrently from any thread
+     * @param value element to push
+     */
+    void push(T value)
+    {
+        Node* node = new Node(std::move(value));
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pop the oldest element, consumer only
+     * @returns the element, or nothing if the queue is empty (or a push is not completed yet)
+     */
+    std::optional<T> pop()
+    {
+        Node* next = tail_->next.load(std::memory_order_acquire);
+        if (!next)
+        {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(next->value));
+        delete tail_;
+        tail_ = next; // next becomes the new stub
+        return value;
+    }
+
+    /**
+     * @brief Check for available elements, consumer only
+     * @returns true if no element can be popped
+     */
+    bool empty() const { return tail_->next.load(std::memory_order_acquire) == nullptr; }
+
+private:
+    struct Node
+    {
+        Node() = default;
+        explicit Node(T&& v) : value(std::move(v)) {}
+
+        std::atomic<Node*> next = nullptr;
+        T value{};
+    };
+
+private:
+    alignas(64) std::atomic<Node*> head_; // producers side
+    alignas(64) Node* tail_;              // consumer side, stub node
+};
+} // namespace util
+} // namespace synchro
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace synchro
+{
+namespace util
+{
+/**
+ * @brief Presence of N elements, with constant time completion test and reset
+ *
+ * Presence is a bitmask of one or more words. Each word is stamped with the generation it was
+ * written in, so that reset only starts a new generation: stale words are zeroed lazily by the
+ * next set. A count of missing elements makes the completion test a single comparison.
+ */
+template<std::size_t N>
+class PresenceMask
+{
+public:
+    /**
+     * @brief Mark an element present
+     * @param index index of the element, lower than N
+     * @returns true if the element was already present
+     */
+    bool set(std::size_t index)
+    {
+        const std::size_t word  = index / 64;
+        const std::uint64_t bit = std::uint64_t(1) << (index % 64);
+        if (stamps_[word] != generation_)
+        {
+            stamps_[word] = generation_;
+            words_[word]  = 0;
+        }
+        if (words_[word] & bit)
+        {
+            return true;
+        }
+        words_[word] |= bit;
+        --missing_;
+        return false;
+    }
+
+    /**
+     * @brief Test presence of an element
+     * @param index index of the element, lower than N
+     * @returns true if the element was marked present since last reset
+     */
+    bool test(std::size_t index) const
+    {
+        const std::size_t word = index / 64;
+        return stamps_[word] == generation_ && (words_[word] & (std::uint64_t(1) << (index % 64))) != 0;
+    }
+
+    /// @returns true if all elements are present
+    bool complete() const { return missing_ == 0; }
+    /// @returns true if no element is present
+    bool empty() const { return missing_ == N; }
+
+    /// @brief Mark all elements missing
+    void reset()
+    {
+        ++generation_;
+        missing_ = N;
+    }
+
+private:
+    static constexpr std::size_t Words = (N + 63) / 64;
+
+    std::array<std::uint64_t, Words> words_{};
+    std::array<std::uint64_t, Words> stamps_{};
+    std::uint64_t generation_ = 1; // words are stale until stamped with the current generation
+    std::size_t missing_      = N;
+};
+} // namespace util
+} // namespace synchro
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Span.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace synchro
+{
+namespace util
+{
+/**
+ * @brief Fixed capacity ring buffer
+ *
+ * Elements are stored in a contiguous storage allocated once at construction. Pushing in a full
+ * buffer or popping from an empty one is a precondition violation.
+ */
+template<class T>
+class RingBuffer
+{
+public:
+    /**
+     * @brief Constructor
+     * @param capacity maximal number of elements, allocated at once
+     */
+    explicit RingBuffer(std::size_t capacity = 0) : elements_(capacity) {}
+
+    /// @returns maximal number of elements
+    std::size_t capacity() const { return elements_.size(); }
+    /// @returns number of elements
+    std::size_t size() const { return size_; }
+    /// @returns true if buffer holds no element
+    bool empty() const { return size_ == 0; }
+    /// @returns true if buffer holds capacity elements
+    bool full() const { return size_ == elements_.size(); }
+
+    /**
+     * @brief Push an element after the newest one, buffer must not be full
+     * @param value element to push
+     */
+    void push(T value)
+    {
+        elements_[(head_ + size_) % elements_.size()] = std::move(value);
+        ++size_;
+    }
+
+    /**
+     * @brief Pop the oldest element, buffer must not be empty
+     * @returns the oldest element
+     */
+    T pop()
+    {
+        T value = std::move(elements_[head_]);
+        elements_[head_] = T{};
+        head_            = (head_ + 1) % elements_.size();
+        --size_;
+        return value;
+    }
+
+    /// @returns the oldest element, buffer must not be empty
+    T& front() { return elements_[head_]; }
+
+    /**
+     * @brief Make elements contiguous, from oldest to newest
+     *
+     * Rotates the storage in place if elements wrap around its end.
+     *
+     * @returns view over elements, valid until next modification
+     */
+    Span<T> linearize()
+    {
+        if (head_ + size_ > elements_.size())
+        {
+            std::rotate(elements_.begin(), elements_.begin() + static_cast<std::ptrdiff_t>(head_), elements_.end());
+            head_ = 0;
+        }
+        return Span<T>(elements_.data() + head_, size_);
+    }
+
+    /// @brief Remove all elements, capacity is kept
+    void clear()
+    {
+        while (size_ > 0)
+        {
+            pop();
+        }
+        head_ = 0;
+    }
+
+private:
+    std::vector<T> elements_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+};
+} // namespace util
+} // namespace synchro
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+namespace synchro
+{
+namespace util
+{
+/**
+ * @brief POSIX shared memory segment mapped in the process
+ *
+ * The segment is created, zero-filled, if it does not exist. It is unmapped on destruction but
+ * persists until removed, so that processes can open it in any order.
+ */
+class SharedMemory
+{
+public:
+    /**
+     * @brief Open or create a segment and map it
+     *
+     * @param name name of the segment, starting with '/'
+     * @param size size of the segment
+     * @throws std::system_error if the segment cannot be opened or mapped, or is smaller than size
+     */
+    SharedMemory(const std::string& name, std::size_t size) : size_(size)
+    {
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+        }
+        struct stat status;
+        if (::fstat(fd, &status) < 0 || (status.st_size == 0 && ::ftruncate(fd, static_cast<off_t>(size)) < 0))
+        {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "shm size " + name);
+        }
+        if (status.st_size != 0 && static_cast<std::size_t>(status.st_size) < size)
+        {
+            ::close(fd);
+            throw std::system_error(EINVAL, std::generic_category(), "shm size " + name);
+        }
+        data_ = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int error = errno;
+        ::close(fd);
+        if (data_ == MAP_FAILED)
+        {
+            throw std::system_error(error, std::generic_category(), "mmap " + name);
+        }
+    }
+
+    ~SharedMemory() { ::munmap(data_, size_); }
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    /// @returns address of the mapping
+    void* data() const { return data_; }
+    /// @returns size of the mapping
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief Remove a segment, mappings stay valid until unmapped
+     * @param name name of the segment
+     * @returns true if the segment existed
+     */
+    static bool remove(const std::string& name) { return ::shm_unlink(name.c_str()) == 0; }
+
+private:
+    void* data_ = nullptr;
+    std::size_t size_;
+};
+} // namespace util
+} // namespace synchro
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+namespace synchro
+{
+namespace util
+{
+/// @brief Non owning view over contiguous elements
+template<class T>
+class Span
+{
+public:
+    Span() = default;
+    /**
+     * @brief Constructor
+     * @param data first element
+     * @param size number of elements
+     */
+    Span(T* data, std::size_t size) : data_(data), size_(size) {}
+
+    /// @returns first element
+    T* data() const { return data_; }
+    /// @returns number of elements
+    std::size_t size() const { return size_; }
+    /// @returns true if there is no element
+    bool empty() const { return size_ == 0; }
+    /// @returns iterator to first element
+    T* begin() const { return data_; }
+    /// @returns iterator past last element
+    T* end() const { return data_ + size_; }
+    /// @returns element at index
+    T& operator[](std::size_t index) const { return data_[index]; }
+
+private:
+    T* data_          = nullptr;
+    std::size_t size_ = 0;
+};
+} // namespace util
+} // namespace synchro
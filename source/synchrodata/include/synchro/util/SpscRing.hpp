@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace synchro
+{
+namespace util
+{
+/**
+ * @brief Bounded single-producer single-consumer queue
+ *
+ * Elements are stored in a power of two ring allocated once at construction. Producer and consumer
+ * indices sit on their own cache lines, each side caching the index of the other so that it is only
+ * reloaded when the ring looks full or empty. Push must only be called from the single producer,
+ * pop from the single consumer.
+ */
+template<class T>
+class SpscRing
+{
+public:
+    /**
+     * @brief Constructor
+     * @param capacity minimal number of elements, rounded up to a power of two
+     */
+    explicit SpscRing(std::size_t capacity) : elements_(roundUp(capacity)), mask_(elements_.size() - 1) {}
+
+    /// @returns maximal number of elements
+    std::size_t capacity() const { return elements_.size(); }
+
+    /**
+     * @brief Push an element if the ring is not full
+     * @param value element to push, only moved from on success
+     * @returns false if the ring is full
+     */
+    bool tryPush(T&& value)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ > mask_)
+        {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ > mask_)
+            {
+                return false;
+            }
+        }
+        elements_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @returns the oldest element, or nothing if the ring is empty
+    std::optional<T> pop()
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_)
+        {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_)
+            {
+                return std::nullopt;
+            }
+        }
+        T value                 = std::move(elements_[head & mask_]);
+        elements_[head & mask_] = T{};
+        head_.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+private:
+    static std::size_t roundUp(std::size_t capacity)
+    {
+        std::size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
+private:
+    std::vector<T> elements_;
+    const std::size_t mask_;
+    alignas(64) std::atomic_size_t head_{0}; // consumer side
+    std::size_t tailCache_ = 0;
+    alignas(64) std::atomic_size_t tail_{0}; // producer side
+    std::size_t headCache_ = 0;
+};
+} // namespace util
+} // namespace synchro
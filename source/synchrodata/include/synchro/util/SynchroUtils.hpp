@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace synchro
 {
@@ -15,6 +17,45 @@ template<class T, class... Ts>
 struct Contains<T, std::tuple<Ts...>> : std::disjunction<std::is_same<T, Ts>...>
 {
 };
+
+/// @brief Trait class to find the index of a type T in the tuple Tuple
+template<class T, class Tuple>
+struct Index;
+/// @brief Specialization when T is the first type
+template<class T, class... Ts>
+struct Index<T, std::tuple<T, Ts...>> : std::integral_constant<std::size_t, 0>
+{
+};
+/// @brief Specialization when T is not the first type
+template<class T, class U, class... Ts>
+struct Index<T, std::tuple<U, Ts...>> : std::integral_constant<std::size_t, 1 + Index<T, std::tuple<Ts...>>::value>
+{
+};
+
+/// @brief Trait class to concatenate tuple types
+template<class... Tuples>
+struct Concat
+{
+    using type = decltype(std::tuple_cat(std::declval<Tuples>()...)); ///< concatenated tuple type
+};
+
+/// @brief Trait class to define the tuple of distinct types of the tuple Tuple which are not in the tuple Excluded
+template<class Tuple, class Excluded = std::tuple<>>
+struct Unique;
+/// @brief Specialization for empty tuple
+template<class Excluded>
+struct Unique<std::tuple<>, Excluded>
+{
+    using type = std::tuple<>; ///< empty tuple type
+};
+/// @brief Specialization keeping the first type unless excluded, then excluding it from the next types
+template<class T, class... Ts, class Excluded>
+struct Unique<std::tuple<T, Ts...>, Excluded>
+{
+    using Next = typename Unique<std::tuple<Ts...>, typename Concat<Excluded, std::tuple<T>>::type>::type;
+    using type = std::conditional_t<Contains<T, Excluded>::value, typename Unique<std::tuple<Ts...>, Excluded>::type,
+                                    typename Concat<std::tuple<T>, Next>::type>; ///< tuple of distinct types
+};
 } // namespace util
 
 } // namespace synchro
@@ -0,0 +1,95 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "synchro/Awaitable.hpp"
+#include "synchro/SynchronizedData.hpp"
+#include "synchro/ThreadPool.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <thread>
+
+using namespace synchro;
+
+struct R1
+{
+};
+struct R2
+{
+};
+struct O1
+{
+};
+struct L1
+{
+};
+
+/// @brief Coroutine started immediately and not awaited
+struct Detached
+{
+    struct promise_type
+    {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+template<class Stream>
+Detached consume(Stream& sets, int count, std::vector<size_t>& listSizes)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const auto& set = co_await sets.next();
+        EXPECT_TRUE(set.template get<R1>());
+        EXPECT_TRUE(set.template get<R2>());
+        listSizes.push_back(set.template list<L1>().size());
+    }
+}
+
+TEST(awaitable, next)
+{
+    using Data = SynchronizedData<Required<R1, R2>, Optional<O1>, List<L1>>;
+    Data data;
+    SetStream<Required<R1, R2>, Optional<O1>, List<L1>> sets(data);
+    std::vector<size_t> listSizes;
+    consume(sets, 2, listSizes); // suspended until first set
+
+    data.send(std::make_shared<L1>());
+    data.send(std::make_shared<R1>());
+    ASSERT_TRUE(listSizes.empty());
+    data.send(std::make_shared<R2>()); // resumes inline
+    ASSERT_EQ(listSizes, std::vector<size_t>{1});
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(listSizes, (std::vector<size_t>{1, 0}));
+
+    // no consumer: sets are merged until the next await
+    data.send(std::make_shared<L1>());
+    data.send(std::make_shared<R1>());
+    data.send(std::make_shared<L1>());
+    data.send(std::make_shared<R2>());
+    consume(sets, 1, listSizes); // not suspended
+    ASSERT_EQ(listSizes, (std::vector<size_t>{1, 0, 2}));
+}
+
+TEST(awaitable, executor)
+{
+    SynchronizedData<Required<R1, R2>, Optional<O1>, List<L1>> data;
+    ThreadPool pool(2);
+    SetStream<Required<R1, R2>, Optional<O1>, List<L1>> sets(data, pool.executor());
+    std::promise<std::thread::id> resumed;
+    [](auto& stream, auto& promise) -> Detached {
+        const auto& set = co_await stream.next();
+        EXPECT_FALSE(set.template get<O1>());
+        promise.set_value(std::this_thread::get_id());
+    }(sets, resumed);
+
+    data.send(std::make_shared<R1>());
+    data.send(std::make_shared<R2>());
+    auto future = resumed.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_NE(future.get(), std::this_thread::get_id());
+}
@@ -1,9 +1,38 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "synchro/ApproximateTimeData.hpp"
+#include "synchro/AsioExecutor.hpp"
 #include "synchro/Broadcaster.hpp"
+#include "synchro/ConcurrentSynchronizedData.hpp"
+#include "synchro/DynamicSynchronizedData.hpp"
+#include "synchro/FastBroadcaster.hpp"
+#include "synchro/IsolatedSynchronizedData.hpp"
+#include "synchro/KeyedSynchronizedData.hpp"
+#include "synchro/ObjectPool.hpp"
+#include "synchro/Pipeline.hpp"
+#include "synchro/Reactor.hpp"
+#include "synchro/Recorder.hpp"
+#include "synchro/ShmPooler.hpp"
 #include "synchro/SynchronizedData.hpp"
 #include "synchro/Synchronizer.hpp"
+#include "synchro/ThreadPool.hpp"
+#include "synchro/TimerWheel.hpp"
+#include "synchro/Trace.hpp"
+#include "synchro/ZipSynchronizedData.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <sstream>
 
 using namespace synchro;
 
@@ -28,6 +57,128 @@ TEST(synchrodata, broadcast)
     ASSERT_EQ(counter, 1);
 }
 
+TEST(synchrodata, fastBroadcast)
+{
+    constexpr int value   = 5;
+    unsigned int counter  = 0;
+    unsigned int counter2 = 0;
+
+    FastBroadcaster<int>::Connection connection2;
+    auto recv = [&value, &counter](const std::shared_ptr<int>& data)
+    {
+        counter++;
+        ASSERT_EQ(*data, value);
+    };
+    // disconnect itself while being notified
+    auto recvOnce = [&counter2, &connection2](const std::shared_ptr<int>&)
+    {
+        counter2++;
+        connection2.disconnect();
+    };
+    {
+        FastBroadcaster<int> broadcaster;
+        auto connection = broadcaster.onReceived(recv);
+        connection2     = broadcaster.onReceived(recvOnce);
+        ASSERT_TRUE(connection.connected());
+        broadcaster.send(std::make_shared<int>(value));
+        ASSERT_EQ(counter, 1);
+        ASSERT_EQ(counter2, 1);
+        ASSERT_FALSE(connection2.connected());
+        broadcaster.send(std::make_shared<int>(value));
+        ASSERT_EQ(counter, 2);
+        ASSERT_EQ(counter2, 1);
+        connection.disconnect();
+        broadcaster.send(std::make_shared<int>(value));
+        ASSERT_EQ(counter, 2);
+
+        broadcaster.onReceived([&counter](const std::shared_ptr<int>&) { counter++; });
+        broadcaster.clear();
+        broadcaster.send(std::make_shared<int>(value));
+        ASSERT_EQ(counter, 2);
+
+        // moved-from broadcaster
+        auto moved = std::move(broadcaster);
+        broadcaster.send(std::make_shared<int>(value));
+        broadcaster.onReceived(recv);
+        broadcaster.send(std::make_shared<int>(value));
+        ASSERT_EQ(counter, 3);
+    }
+    // broadcaster is gone, disconnection is still safe
+    connection2.disconnect();
+}
+
+TEST(synchrodata, executor)
+{
+    constexpr int count = 100;
+    std::vector<int> slow_values;
+    std::atomic_int fast_count = 0;
+    std::thread::id sender     = std::this_thread::get_id();
+    bool other_thread          = true;
+    auto slow = [&slow_values, &sender, &other_thread](const std::shared_ptr<int>& data)
+    {
+        other_thread = other_thread && std::this_thread::get_id() != sender;
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+        slow_values.push_back(*data);
+    };
+    {
+        ThreadPool pool(4);
+        FastBroadcaster<int> broadcaster;
+        broadcaster.onReceived(slow, pool.executor());
+        broadcaster.onReceived([&fast_count](const std::shared_ptr<int>&) { ++fast_count; }, pool.executor());
+        for (int i = 0; i < count; ++i)
+        {
+            broadcaster.send(std::make_shared<int>(i));
+        }
+    } // pool runs remaining tasks
+    ASSERT_EQ(fast_count, count);
+    ASSERT_EQ(slow_values.size(), count);
+    ASSERT_TRUE(std::is_sorted(slow_values.begin(), slow_values.end())); // order is kept by subscriber
+    ASSERT_TRUE(other_thread);
+
+    // asio executor
+    boost::asio::io_context context;
+    Broadcaster<int> broadcaster;
+    int received = 0;
+    broadcaster.onReceived([&received](const std::shared_ptr<int>&) { ++received; }, makeAsioExecutor(boost::asio::make_strand(context)));
+    broadcaster.send(std::make_shared<int>(0));
+    ASSERT_EQ(received, 0);
+    context.run();
+    ASSERT_EQ(received, 1);
+}
+
+TEST(synchrodata, mailbox)
+{
+    constexpr int count = 200;
+    std::vector<int> blocked_values;
+    std::vector<int> conflated_values;
+    auto slow = [](std::vector<int>& values)
+    {
+        return [&values](const std::shared_ptr<int>& data)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            values.push_back(*data);
+        };
+    };
+    std::atomic_int fast_count = 0;
+    {
+        ThreadPool pool(3);
+        FastBroadcaster<int> broadcaster;
+        broadcaster.onReceived(slow(blocked_values), pool.executor(), MailboxMode::Block, 8);
+        broadcaster.onReceived(slow(conflated_values), pool.executor(), MailboxMode::Conflate);
+        broadcaster.onReceived([&fast_count](const std::shared_ptr<int>&) { ++fast_count; }, pool.executor(), MailboxMode::Conflate);
+        for (int i = 0; i < count; ++i)
+        {
+            broadcaster.send(std::make_shared<int>(i));
+        }
+    } // pool runs remaining tasks
+    ASSERT_EQ(blocked_values.size(), count); // lossless
+    ASSERT_TRUE(std::is_sorted(blocked_values.begin(), blocked_values.end()));
+    ASSERT_LT(conflated_values.size(), count); // fewer, newer elements
+    ASSERT_TRUE(std::is_sorted(conflated_values.begin(), conflated_values.end()));
+    ASSERT_EQ(conflated_values.back(), count - 1);
+    ASSERT_GT(fast_count, 0);
+}
+
 struct R1
 {
 };
@@ -62,6 +213,70 @@ TEST(synchrodata, data)
     ASSERT_TRUE(received_opt);
 }
 
+TEST(synchrodata, dynamicData)
+{
+    DynamicSynchronizedData<> data;
+    const auto r1 = data.addStream(Role::Required);
+    const auto o1 = data.addStream(Role::Optional);
+    const auto l1 = data.addStream(Role::List, 2, OverflowPolicy::DropOldest);
+    const auto r2 = data.addStream(Role::Required);
+    ASSERT_THROW(data.addStream(Role::List, 2, OverflowPolicy::Block), std::invalid_argument);
+
+    std::vector<std::string> received;
+    auto record = [&received](const std::string& name) { return [&received, name](const std::shared_ptr<void>&) { received.push_back(name); }; };
+    data.onReceived(r1, record("r1"));
+    data.onReceived(o1, record("o1"));
+    data.onReceived(l1, record("l1"));
+    data.onReceived(r2, record("r2"));
+    std::size_t listed = 0;
+    data.onSynchronized(
+        [&](const DynamicSynchronizedData<>::Set& set)
+        {
+            ASSERT_TRUE(set.get<R1>(r1));
+            ASSERT_TRUE(set.get(r2));
+            listed = set.list(l1).size();
+        });
+
+    for (int i = 0; i < 3; ++i)
+    {
+        data.send(l1, std::make_shared<L1>());
+    }
+    data.send(o1, std::make_shared<O1>());
+    data.send(r1, std::make_shared<R1>());
+    data.send(r1, std::make_shared<R1>()); // overwrites pending
+    ASSERT_TRUE(received.empty());
+    data.send(r2, std::make_shared<R2>());
+    ASSERT_EQ(listed, 2);
+    ASSERT_EQ(data.dropped(l1), 1);
+    ASSERT_EQ(received, (std::vector<std::string>{"r2", "r1", "o1", "l1", "l1"}));
+
+    received.clear();
+    data.send(o1, std::make_shared<O1>());
+    data.send(r1, std::make_shared<R1>());
+    ASSERT_EQ(received, (std::vector<std::string>{"o1", "r1"}));
+}
+
+TEST(synchrodata, fastPolicy)
+{
+    SynchronizedData<Required<R1, R2>, Optional<O1>, List<L1>, FastPolicy> data;
+    bool received              = false;
+    unsigned int received_list = 0;
+    auto connection            = data.onReceived<R1>([&received](const std::shared_ptr<R1>&) { received = true; });
+    auto connection_list       = data.onReceived<L1>([&received_list](const std::shared_ptr<L1>&) { ++received_list; });
+
+    data.send<L1>(std::make_shared<L1>());
+    data.send<R1>(std::make_shared<R1>());
+    ASSERT_FALSE(received);
+    data.send<R2>(std::make_shared<R2>());
+    ASSERT_TRUE(received);
+    ASSERT_EQ(received_list, 1);
+
+    connection.disconnect();
+    received = false;
+    data.send<R1>(std::make_shared<R1>());
+    ASSERT_FALSE(received);
+}
+
 TEST(synchrodata, waitingData)
 {
     SynchronizedData<Required<R1, R2>, Optional<O1, O2>, List<L1>> data;
@@ -110,6 +325,737 @@ TEST(synchrodata, waitingData)
     ASSERT_FALSE(received);
 }
 
+TEST(synchrodata, synchronizedSet)
+{
+    using Data = SynchronizedData<Required<R1, R2>, Optional<O1, O2>, List<L1>>;
+    Data data;
+    size_t sets     = 0;
+    size_t o1_count = 0;
+    size_t l1_count = 0;
+    std::shared_ptr<R2> r2;
+    data.onSynchronized(
+        [&](const Data::Set& set)
+        {
+            ++sets;
+            ASSERT_TRUE(set.get<R1>());
+            ASSERT_EQ(set.get<R2>(), r2);
+            ASSERT_FALSE(set.get<O2>());
+            o1_count += set.get<O1>() ? 1 : 0;
+            l1_count += set.list<L1>().size();
+        });
+
+    data.send(std::make_shared<L1>());
+    data.send(std::make_shared<O1>());
+    data.send(std::make_shared<L1>());
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(sets, 0);
+    r2 = std::make_shared<R2>();
+    data.send(r2);
+    ASSERT_EQ(sets, 1);
+    ASSERT_EQ(o1_count, 1);
+    ASSERT_EQ(l1_count, 2);
+
+    // then one set by required element, holding other required elements
+    data.send(std::make_shared<L1>());
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(sets, 2);
+    ASSERT_EQ(o1_count, 1);
+    ASSERT_EQ(l1_count, 3);
+    data.send(std::make_shared<O1>());
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(sets, 3);
+    ASSERT_EQ(o1_count, 2);
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(sets, 4);
+    ASSERT_EQ(o1_count, 2);
+    ASSERT_EQ(l1_count, 3);
+
+    // once all callbacks are disconnected, elements are not kept for sets anymore
+    Data unsubscribed;
+    unsubscribed.onSynchronized([](const Data::Set&) {}).disconnect();
+    unsubscribed.send(std::make_shared<R2>());
+    unsubscribed.send(std::make_shared<R1>());
+    const auto o1 = std::make_shared<O1>();
+    unsubscribed.send(o1);
+    ASSERT_EQ(o1.use_count(), 1);
+}
+
+TEST(synchrodata, latest)
+{
+    SynchronizedData<Required<R1, R2>, Optional<O1>, List<>, LatestPolicy> data;
+    ASSERT_FALSE(data.latest());
+
+    auto r1 = std::make_shared<R1>();
+    data.send(r1);
+    ASSERT_FALSE(data.latest());
+    data.send(std::make_shared<O1>());
+    data.send(std::make_shared<R2>());
+
+    auto first = data.latest();
+    ASSERT_TRUE(first);
+    ASSERT_EQ(first->get<R1>(), r1);
+    ASSERT_TRUE(first->get<O1>());
+
+    // pinned sets are not rewritten, newer sets are published in other buffers
+    std::vector<decltype(data.latest())> pinned;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto r = std::make_shared<R1>();
+        data.send(r);
+        pinned.push_back(data.latest());
+        ASSERT_EQ(pinned.back()->get<R1>(), r);
+        ASSERT_FALSE(pinned.back()->get<O1>());
+    }
+    ASSERT_EQ(first->get<R1>(), r1);
+
+    // all buffers pinned, the set is not published
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(data.latest()->get<R1>(), pinned.back()->get<R1>());
+    pinned.clear();
+    auto r = std::make_shared<R1>();
+    data.send(r);
+    ASSERT_EQ(data.latest()->get<R1>(), r);
+}
+
+TEST(synchrodata, metrics)
+{
+    SynchronizedData<Required<R1, R2>, Optional<O1>, List<L1>, MetricsPolicy> data;
+    data.configureList<L1>(2, OverflowPolicy::DropOldest);
+    data.onReceived<R1>([](const std::shared_ptr<R1>&) { std::this_thread::sleep_for(std::chrono::microseconds(100)); });
+
+    data.send(std::make_shared<R1>());
+    data.send(std::make_shared<R1>());
+    data.send(std::make_shared<O1>());
+    for (size_t i = 0; i < 3; ++i)
+    {
+        data.send(std::make_shared<L1>());
+    }
+    auto snapshot = data.metrics().snapshot();
+    ASSERT_EQ(snapshot.size(), 4);
+    ASSERT_EQ(snapshot[0].received, 2);
+    ASSERT_EQ(snapshot[0].overwritten, 1);
+    ASSERT_EQ(snapshot[0].dispatched, 0);
+    ASSERT_EQ(snapshot[3].received, 3);
+    ASSERT_EQ(snapshot[3].dropped, 1);
+    ASSERT_EQ(snapshot[3].depth, 2);
+
+    data.send(std::make_shared<R2>());
+    data.send(std::make_shared<R1>());
+    snapshot = data.metrics().snapshot();
+    ASSERT_EQ(snapshot[0].dispatched, 2);
+    ASSERT_EQ(snapshot[0].synchronize.count(), 1);
+    ASSERT_EQ(snapshot[0].dispatch.count(), 2);
+    ASSERT_GE(snapshot[0].dispatch.percentile(0.5), 100000);
+    ASSERT_EQ(snapshot[1].synchronize.count(), 0); // never pending
+    ASSERT_EQ(snapshot[2].dispatched, 1);
+    ASSERT_EQ(snapshot[3].dispatched, 2);
+    ASSERT_EQ(snapshot[3].depth, 0);
+
+    // disabled metrics
+    SynchronizedData<Required<R1>> noMetrics;
+    ASSERT_TRUE(noMetrics.metrics().snapshot().empty());
+}
+
+TEST(synchrodata, histogram)
+{
+    for (std::uint64_t value : {0ull, 7ull, 8ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull})
+    {
+        const auto bucket = LatencyHistogram::bucket(value);
+        ASSERT_GE(LatencyHistogram::upperBound(bucket), value);
+        ASSERT_TRUE(bucket == 0 || LatencyHistogram::upperBound(bucket - 1) < value);
+    }
+    ASSERT_EQ(LatencyHistogram::bucket(~0ull), LatencyHistogram::Buckets - 1);
+}
+
+TEST(synchrodata, trace)
+{
+    auto& tracer = trace::Tracer::instance();
+    tracer.clear();
+    std::thread([] { trace::record(trace::Event::Arrival, typeid(R1).name()); }).join();
+    trace::record(trace::Event::DispatchBegin, typeid(R1).name());
+    trace::record(trace::Event::DispatchEnd, typeid(R1).name());
+
+    std::ostringstream out;
+    tracer.exportChrome(out);
+    const std::string json = out.str();
+    ASSERT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0);
+    ASSERT_NE(json.find("\"name\":\"arrival R1\",\"cat\":\"synchro\",\"ph\":\"i\""), std::string::npos);
+    ASSERT_NE(json.find("\"name\":\"dispatch R1\",\"cat\":\"synchro\",\"ph\":\"B\""), std::string::npos);
+    ASSERT_NE(json.find("\"ph\":\"E\""), std::string::npos);
+    ASSERT_LT(json.find("\"ph\":\"B\""), json.find("\"ph\":\"E\""));
+
+    tracer.clear();
+    std::ostringstream cleared;
+    tracer.exportChrome(cleared);
+#ifndef SYNCHRO_ENABLE_TRACING
+    ASSERT_EQ(cleared.str(), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[]}\n");
+#else
+    // a dispatch slice by callback
+    Broadcaster<int> broadcaster;
+    FastBroadcaster<int> fast;
+    for (int i = 0; i < 2; ++i)
+    {
+        broadcaster.onReceived([](const std::shared_ptr<int>&) {});
+        fast.onReceived([](const std::shared_ptr<int>&) {});
+    }
+    broadcaster.send(std::make_shared<int>(0));
+    fast.send(std::make_shared<int>(0));
+    std::ostringstream dispatched;
+    tracer.exportChrome(dispatched);
+    const std::string slices_json = dispatched.str();
+    size_t slices                 = 0;
+    for (auto pos = slices_json.find("\"ph\":\"B\""); pos != std::string::npos; pos = slices_json.find("\"ph\":\"B\"", pos + 1))
+    {
+        ++slices;
+    }
+    ASSERT_EQ(slices, 4);
+    tracer.clear();
+#endif
+
+    // buffers of exited threads are reused
+    auto traced = [] { trace::record(trace::Event::Arrival, typeid(R1).name()); };
+    std::thread(traced).join();
+    const auto buffers = tracer.buffers();
+    for (int i = 0; i < 8; ++i)
+    {
+        std::thread(traced).join();
+    }
+    ASSERT_EQ(tracer.buffers(), buffers);
+
+    // threads sharing a buffer are exported with their own thread id
+    tracer.clear();
+    std::thread(traced).join();
+    std::thread(traced).join();
+    std::ostringstream reused;
+    tracer.exportChrome(reused);
+    const std::string reused_json = reused.str();
+    const auto first              = reused_json.find("\"tid\":");
+    const auto second             = reused_json.find("\"tid\":", first + 1);
+    ASSERT_NE(second, std::string::npos);
+    ASSERT_NE(std::stoul(reused_json.substr(first + 6)), std::stoul(reused_json.substr(second + 6)));
+}
+
+TEST(synchrodata, presenceMask)
+{
+    util::PresenceMask<70> mask; // more than one word
+    for (std::size_t i = 0; i < 70; ++i)
+    {
+        ASSERT_FALSE(mask.complete());
+        ASSERT_FALSE(mask.set(i));
+    }
+    ASSERT_TRUE(mask.set(65));
+    ASSERT_TRUE(mask.complete());
+
+    mask.reset();
+    ASSERT_TRUE(mask.empty());
+    ASSERT_FALSE(mask.set(65)); // stale word is not present anymore
+    ASSERT_FALSE(mask.complete());
+}
+
+TEST(synchrodata, listOverflow)
+{
+    SynchronizedData<Required<R1>, Optional<>, List<L1, L2>> data;
+    data.configureList<L1>(2, OverflowPolicy::DropOldest);
+    data.configureList<L2>(2, OverflowPolicy::DropNewest);
+    std::vector<std::shared_ptr<L1>> l1_received;
+    std::vector<std::shared_ptr<L2>> l2_received;
+    data.onReceived<L1>([&l1_received](const std::shared_ptr<L1>& l1) { l1_received.push_back(l1); });
+    data.onReceived<L2>([&l2_received](const std::shared_ptr<L2>& l2) { l2_received.push_back(l2); });
+
+    std::vector<std::shared_ptr<L1>> l1_sent;
+    std::vector<std::shared_ptr<L2>> l2_sent;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        l1_sent.push_back(std::make_shared<L1>());
+        l2_sent.push_back(std::make_shared<L2>());
+        data.send(l1_sent.back());
+        data.send(l2_sent.back());
+    }
+    ASSERT_EQ(data.dropped<L1>(), 1);
+    ASSERT_EQ(data.dropped<L2>(), 1);
+
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(l1_received, std::vector<std::shared_ptr<L1>>(l1_sent.begin() + 1, l1_sent.end()));
+    ASSERT_EQ(l2_received, std::vector<std::shared_ptr<L2>>(l2_sent.begin(), l2_sent.end() - 1));
+
+    // pending elements dropped by a new configuration are counted
+    SynchronizedData<Required<R1>, Optional<>, List<L1>> reconfigured;
+    reconfigured.send(std::make_shared<L1>());
+    reconfigured.configureList<L1>(4, OverflowPolicy::DropNewest);
+    ASSERT_EQ(reconfigured.dropped<L1>(), 1);
+}
+
+TEST(synchrodata, listOverflowBlock)
+{
+    SynchronizedData<Required<R1>, Optional<>, List<L1>> data;
+    ASSERT_THROW(data.configureList<L1>(0, OverflowPolicy::Block), std::invalid_argument);
+    data.configureList<L1>(1, OverflowPolicy::Block);
+    std::vector<std::shared_ptr<L1>> l1_received;
+    data.onReceived<L1>([&l1_received](const std::shared_ptr<L1>& l1) { l1_received.push_back(l1); }); // called under the lock of the senders
+
+    const auto pending = std::make_shared<L1>();
+    const auto blocked = std::make_shared<L1>();
+    data.send(pending);
+    std::atomic_bool sent = false;
+    std::thread producer(
+        [&data, &sent, &blocked]
+        {
+            data.send(blocked); // blocks until pending list is sent
+            sent = true;
+        });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_FALSE(sent);
+    data.send(std::make_shared<R1>());
+    producer.join();
+    ASSERT_TRUE(sent);
+    ASSERT_EQ(l1_received, (std::vector<std::shared_ptr<L1>>{pending, blocked})); // the blocked element is notified right after the set
+    ASSERT_EQ(data.dropped<L1>(), 0);
+
+    // once synchronized, elements kept for the next set neither block nor count as dropped
+    auto connection = data.onSynchronized([](const auto&) {});
+    data.send(std::make_shared<L1>());
+    data.send(std::make_shared<L1>());
+    data.send(std::make_shared<L1>());
+    ASSERT_EQ(data.dropped<L1>(), 0);
+}
+
+TEST(synchrodata, listBatch)
+{
+    SynchronizedData<Required<R1>, Optional<>, List<L1, L2>> data;
+    std::vector<size_t> l1_batches;
+    std::vector<size_t> l2_batches;
+    std::vector<std::shared_ptr<L1>> l1_received;
+    auto c1 = data.onBatch<L1>(
+        [&l1_batches, &l1_received](util::Span<const std::shared_ptr<L1>> batch)
+        {
+            l1_batches.push_back(batch.size());
+            l1_received.insert(l1_received.end(), batch.begin(), batch.end());
+        },
+        BatchMode::everyCount(2));
+    auto c2 = data.onBatch<L2>([&l2_batches](util::Span<const std::shared_ptr<L2>> batch) { l2_batches.push_back(batch.size()); }, BatchMode::onSet());
+
+    // pending elements are aggregated once synchronized
+    std::vector<std::shared_ptr<L1>> l1_sent;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        l1_sent.push_back(std::make_shared<L1>());
+        data.send(l1_sent.back());
+        data.send(std::make_shared<L2>());
+    }
+    ASSERT_TRUE(l1_batches.empty());
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(l1_batches, std::vector<size_t>({2}));
+    ASSERT_EQ(l2_batches, std::vector<size_t>({3}));
+
+    l1_sent.push_back(std::make_shared<L1>());
+    data.send(l1_sent.back());
+    data.send(std::make_shared<L2>());
+    ASSERT_EQ(l1_batches, std::vector<size_t>({2, 2}));
+    ASSERT_EQ(l2_batches, std::vector<size_t>({3}));
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(l2_batches, std::vector<size_t>({3, 1}));
+    ASSERT_EQ(l1_received, l1_sent);
+
+    // each callback keeps its mode, windows are checked on arrival only
+    std::vector<size_t> window_batches;
+    auto c3 = data.onBatch<L2>([&window_batches](util::Span<const std::shared_ptr<L2>> batch) { window_batches.push_back(batch.size()); },
+                               BatchMode::everyWindow(std::chrono::milliseconds(5)));
+    data.send(std::make_shared<L2>());
+    data.send(std::make_shared<L2>());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_TRUE(window_batches.empty()); // idle stream, held until the next element
+    data.send(std::make_shared<L2>());
+    ASSERT_EQ(window_batches, std::vector<size_t>({3}));
+    ASSERT_EQ(l2_batches, std::vector<size_t>({3, 1}));
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(l2_batches, std::vector<size_t>({3, 1, 3}));
+    ASSERT_EQ(window_batches, std::vector<size_t>({3}));
+
+    // elements of a disconnected callback are released with the next element
+    auto held = std::make_shared<L1>();
+    data.send(held);
+    c1.disconnect();
+    data.send(std::make_shared<L1>());
+    ASSERT_EQ(held.use_count(), 1);
+}
+
+TEST(synchrodata, concurrentData)
+{
+    constexpr size_t count = 1000;
+    ConcurrentSynchronizedData<Required<R1, R2>, Optional<O1>, List<L1>> data;
+    size_t r1_count = 0;
+    size_t l1_count = 0;
+    ASSERT_THROW(data.configureList<L1>(count, OverflowPolicy::Block), std::invalid_argument);
+    data.configureList<L1>(count, OverflowPolicy::DropOldest);
+    data.onReceived<R1>([&r1_count](const std::shared_ptr<R1>&) { ++r1_count; });
+    data.onReceived<L1>([&l1_count](const std::shared_ptr<L1>&) { ++l1_count; });
+
+    std::vector<std::thread> producers;
+    producers.emplace_back([&data] { for (size_t i = 0; i < count; ++i) data.send(std::make_shared<R1>()); });
+    producers.emplace_back([&data] { for (size_t i = 0; i < count; ++i) data.send(std::make_shared<L1>()); });
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    data.flush();
+    ASSERT_EQ(r1_count, 0); // R2 never received
+    ASSERT_EQ(l1_count, 0);
+
+    data.send(std::make_shared<R2>());
+    data.flush();
+    ASSERT_EQ(r1_count, 1); // only the last one is sent
+    ASSERT_EQ(l1_count, count);
+    ASSERT_EQ(data.dropped<L1>(), 0);
+
+    data.clear();
+    data.send(std::make_shared<R1>());
+    data.flush();
+    ASSERT_EQ(r1_count, 1);
+}
+
+struct S1
+{
+    int stamp;
+};
+struct S2
+{
+    int stamp;
+};
+struct StampOf
+{
+    template<class T>
+    int operator()(const T& data) const
+    {
+        return data.stamp;
+    }
+};
+
+TEST(synchrodata, isolatedData)
+{
+    IsolatedSynchronizedData<Required<R1, R2>, Optional<O1>> data;
+    size_t r1_count = 0;
+    size_t o1_count = 0;
+    data.onReceived<R1>([&r1_count](const std::shared_ptr<R1>&) { ++r1_count; });
+    data.onReceived<O1>([&o1_count](const std::shared_ptr<O1>&) { ++o1_count; });
+    data.send(std::make_shared<R1>());
+    data.send(std::make_shared<R1>());
+    data.send(std::make_shared<O1>());
+    ASSERT_FALSE(data.synchronized());
+    ASSERT_EQ(r1_count, 0);
+    data.send(std::make_shared<R2>());
+    ASSERT_TRUE(data.synchronized());
+    ASSERT_EQ(r1_count, 1); // only the last one is sent
+    ASSERT_EQ(o1_count, 1);
+    data.send(std::make_shared<R1>());
+    ASSERT_EQ(r1_count, 2);
+
+    // listed elements are all sent in order once synchronized
+    IsolatedSynchronizedData<Required<R1>, Optional<>, List<S1>> listed;
+    std::vector<int> l_stamps;
+    listed.onReceived<S1>([&l_stamps](const std::shared_ptr<S1>& s1) { l_stamps.push_back(s1->stamp); });
+    listed.send(std::make_shared<S1>(S1{0}));
+    listed.send(std::make_shared<S1>(S1{1}));
+    ASSERT_TRUE(l_stamps.empty());
+    listed.send(std::make_shared<R1>());
+    listed.send(std::make_shared<S1>(S1{2}));
+    ASSERT_EQ(l_stamps, (std::vector<int>{0, 1, 2}));
+    ASSERT_EQ(listed.dropped<S1>(), 0);
+
+    // concurrent producers, each element is notified at most once and the last ones are notified
+    constexpr int count = 1000;
+    IsolatedSynchronizedData<Required<S1, S2>, Optional<O1>, List<>, FastPolicy> concurrent;
+    std::mutex mutex; // pending elements are notified by the other producer
+    std::vector<int> s1_stamps;
+    std::vector<int> s2_stamps;
+    concurrent.onReceived<S1>(
+        [&mutex, &s1_stamps](const std::shared_ptr<S1>& s1)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            s1_stamps.push_back(s1->stamp);
+        });
+    concurrent.onReceived<S2>(
+        [&mutex, &s2_stamps](const std::shared_ptr<S2>& s2)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            s2_stamps.push_back(s2->stamp);
+        });
+    std::thread s1_producer([&concurrent] { for (int i = 0; i < count; ++i) concurrent.send(std::make_shared<S1>(S1{i})); });
+    std::thread s2_producer([&concurrent] { for (int i = 0; i < count; ++i) concurrent.send(std::make_shared<S2>(S2{i})); });
+    s1_producer.join();
+    s2_producer.join();
+    for (auto* stamps : {&s1_stamps, &s2_stamps})
+    {
+        ASSERT_FALSE(stamps->empty());
+        std::sort(stamps->begin(), stamps->end());
+        ASSERT_EQ(std::adjacent_find(stamps->begin(), stamps->end()), stamps->end());
+        ASSERT_EQ(stamps->back(), count - 1);
+    }
+}
+
+TEST(synchrodata, approximateTime)
+{
+    ApproximateTimeData<Required<S1, S2>, StampOf, 4> data(2);
+    std::vector<std::pair<int, int>> sets;
+    int s1_stamp = -1;
+    data.onReceived<S1>([&s1_stamp](const std::shared_ptr<S1>& s1) { s1_stamp = s1->stamp; });
+    data.onReceived<S2>([&s1_stamp, &sets](const std::shared_ptr<S2>& s2) { sets.emplace_back(s1_stamp, s2->stamp); });
+
+    data.send(std::make_shared<S1>(S1{0}));
+    data.send(std::make_shared<S1>(S1{10}));
+    data.send(std::make_shared<S1>(S1{20}));
+    ASSERT_TRUE(sets.empty());
+    data.send(std::make_shared<S2>(S2{11})); // S1 0 cannot match anymore
+    ASSERT_EQ(sets.size(), 1);
+    ASSERT_EQ(sets.back(), std::make_pair(10, 11));
+    ASSERT_EQ(data.dropped<S1>(), 1);
+    data.send(std::make_shared<S2>(S2{15})); // too far from S1 20, too late for S1 10
+    ASSERT_EQ(sets.size(), 1);
+    ASSERT_EQ(data.dropped<S2>(), 1);
+    data.send(std::make_shared<S2>(S2{19}));
+    ASSERT_EQ(sets.size(), 2);
+    ASSERT_EQ(sets.back(), std::make_pair(20, 19));
+
+    // history overflow drops oldest elements
+    for (int stamp = 30; stamp < 40; ++stamp)
+    {
+        data.send(std::make_shared<S1>(S1{stamp}));
+    }
+    ASSERT_EQ(data.dropped<S1>(), 7);
+    data.send(std::make_shared<S2>(S2{30}));
+    ASSERT_EQ(sets.size(), 2);
+    data.send(std::make_shared<S2>(S2{37}));
+    ASSERT_EQ(sets.back(), std::make_pair(36, 37));
+}
+
+TEST(synchrodata, timerWheel)
+{
+    using namespace std::chrono_literals;
+    TimerWheel wheel(1ms);
+    std::vector<int> fired;
+    TimerWheel::Timer t1([&fired] { fired.push_back(1); });
+    TimerWheel::Timer t2([&fired] { fired.push_back(2); });
+    TimerWheel::Timer t3([&fired] { fired.push_back(3); });
+    TimerWheel::Timer t4([&fired] { fired.push_back(4); });
+
+    const auto start = TimerWheel::Clock::now();
+    wheel.schedule(t1, 10ms);
+    wheel.schedule(t2, 100ms);  // second wheel
+    wheel.schedule(t3, 5000ms); // third wheel
+    wheel.schedule(t4, 50ms);
+    ASSERT_TRUE(t4.scheduled());
+    wheel.cancel(t4);
+    ASSERT_FALSE(t4.scheduled());
+
+    ASSERT_EQ(wheel.advance(start + 9ms), 0);
+    ASSERT_EQ(wheel.advance(start + 12ms), 1);
+    ASSERT_EQ(wheel.advance(start + 99ms), 0);
+    ASSERT_EQ(wheel.advance(start + 102ms), 1);
+    ASSERT_EQ(wheel.advance(start + 4999ms), 0);
+    ASSERT_EQ(wheel.advance(start + 5002ms), 1);
+    ASSERT_EQ(fired, (std::vector<int>{1, 2, 3}));
+    ASSERT_FALSE(t1.scheduled());
+
+    // expired and cancelled timers may outlive their wheel
+    TimerWheel::Timer expired([&fired] { fired.push_back(5); });
+    TimerWheel::Timer cancelled([&fired] { fired.push_back(6); });
+    {
+        TimerWheel short_lived(1ms);
+        const auto now = TimerWheel::Clock::now();
+        short_lived.schedule(expired, 1ms);
+        short_lived.schedule(cancelled, 1ms);
+        short_lived.cancel(cancelled);
+        ASSERT_EQ(short_lived.advance(now + 5ms), 1);
+    }
+    ASSERT_EQ(fired.back(), 5);
+}
+
+TEST(synchrodata, deadline)
+{
+    using namespace std::chrono_literals;
+    TimerWheel wheel(1ms);
+    SynchronizedData<Required<R1, R2>, Optional<O1>, List<L1>> emitting;
+    SynchronizedData<Required<R1, R2>> discarding;
+    emitting.setDeadline(wheel, 10ms, DeadlineAction::Emit);
+    discarding.setDeadline(wheel, 10ms, DeadlineAction::Discard);
+    size_t r1_count = 0;
+    size_t l1_count = 0;
+    size_t partial  = 0;
+    emitting.onReceived<R1>([&r1_count](const std::shared_ptr<R1>&) { ++r1_count; });
+    emitting.onReceived<L1>([&l1_count](const std::shared_ptr<L1>&) { ++l1_count; });
+    emitting.onSynchronized([&partial](const auto& set) { partial += set.template get<R2>() ? 0 : 1; });
+    discarding.onReceived<R1>([&r1_count](const std::shared_ptr<R1>&) { ++r1_count; });
+
+    emitting.send(std::make_shared<R1>());
+    emitting.send(std::make_shared<L1>());
+    auto discarded = std::make_shared<R1>();
+    discarding.send(discarded);
+    ASSERT_EQ(discarded.use_count(), 2);
+    wheel.advance(TimerWheel::Clock::now() + 5ms);
+    ASSERT_EQ(r1_count, 0);
+    wheel.advance(TimerWheel::Clock::now() + 15ms);
+    ASSERT_EQ(r1_count, 1); // partial set emitted
+    ASSERT_EQ(l1_count, 1);
+    ASSERT_EQ(partial, 1);
+    ASSERT_EQ(discarded.use_count(), 1); // released on expiry
+
+    emitting.send(std::make_shared<L1>()); // synchronized, notified immediately
+    ASSERT_EQ(l1_count, 2);
+    auto pending = std::make_shared<R2>();
+    discarding.send(pending); // R1 was discarded
+    ASSERT_EQ(r1_count, 1);
+    discarding.send(std::make_shared<R1>()); // completes the new set, the discarded R1 is not notified
+    ASSERT_EQ(r1_count, 2);
+    ASSERT_EQ(pending.use_count(), 1); // released once the set is complete
+
+    // expiry run by the dispatcher thread
+    ConcurrentSynchronizedData<Required<R1, R2>> concurrent;
+    std::promise<void> received;
+    concurrent.onReceived<R1>([&received](const std::shared_ptr<R1>&) { received.set_value(); });
+    concurrent.setDeadline(wheel, 10ms, DeadlineAction::Emit);
+    wheel.start();
+    ASSERT_THROW(discarding.setDeadline(wheel, 10ms, DeadlineAction::Discard), std::invalid_argument); // inline expiry would race with send
+    concurrent.send(std::make_shared<R1>());
+    ASSERT_EQ(received.get_future().wait_for(5s), std::future_status::ready);
+    wheel.stop();
+}
+
+TEST(synchrodata, zipData)
+{
+    ZipSynchronizedData<Required<R1, R2>> data(2);
+    std::vector<std::pair<std::shared_ptr<R1>, std::shared_ptr<R2>>> sets;
+    auto connection = data.onSynchronized([&sets](const auto& set) { sets.emplace_back(set.template get<R1>(), set.template get<R2>()); });
+    size_t r2_count = 0;
+    data.onReceived<R2>([&r2_count](const std::shared_ptr<R2>&) { ++r2_count; });
+
+    // every element is paired, in order
+    std::vector<std::shared_ptr<R1>> r1_sent = {std::make_shared<R1>(), std::make_shared<R1>(), std::make_shared<R1>()};
+    std::vector<std::shared_ptr<R2>> r2_sent = {std::make_shared<R2>(), std::make_shared<R2>(), std::make_shared<R2>()};
+    ASSERT_TRUE(data.trySend(r1_sent[0]));
+    ASSERT_TRUE(data.trySend(r1_sent[1]));
+    ASSERT_FALSE(data.trySend(r1_sent[2])); // high-water mark
+    ASSERT_EQ(data.queued<R1>(), 2);
+    data.send(r2_sent[0]);
+    ASSERT_TRUE(data.trySend(r1_sent[2]));
+    data.send(r2_sent[1]);
+    ASSERT_EQ(sets.size(), 2);
+    ASSERT_EQ(r2_count, 2);
+    ASSERT_EQ(data.queued<R1>(), 1);
+
+    // send blocks until the queue is below the high-water mark
+    data.send(std::make_shared<R1>());
+    std::atomic_bool sent = false;
+    std::thread producer(
+        [&data, &sent]
+        {
+            data.send(std::make_shared<R1>());
+            sent = true;
+        });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_FALSE(sent);
+    data.send(r2_sent[2]);
+    producer.join();
+    ASSERT_TRUE(sent);
+    ASSERT_EQ(sets.size(), 3);
+    ASSERT_EQ(data.queued<R1>(), 2);
+    for (size_t i = 0; i < sets.size(); ++i)
+    {
+        ASSERT_EQ(sets[i].first, r1_sent[i]);
+        ASSERT_EQ(sets[i].second, r2_sent[i]);
+    }
+}
+
+TEST(synchrodata, objectPool)
+{
+    std::shared_ptr<S1> kept;
+    {
+        ObjectPool<S1> pool(2);
+        Broadcaster<S1> broadcaster;
+        int stamps = 0;
+        broadcaster.onReceived([&stamps](const std::shared_ptr<S1>& data) { stamps += data->stamp; });
+
+        broadcaster.send(pool.make(S1{1}));
+        broadcaster.send(pool.make(S1{2})); // recycles the first block
+        ASSERT_EQ(stamps, 3);
+        ASSERT_EQ(pool.stats().hits, 2);
+
+        auto first  = pool.make(S1{3});
+        auto second = pool.make(S1{4});
+        auto third  = pool.make(S1{5}); // exhausted
+        ASSERT_EQ(pool.stats().hits, 4);
+        ASSERT_EQ(pool.stats().misses, 1);
+        ASSERT_EQ(third->stamp, 5);
+
+        third.reset();
+        first.reset();
+        ASSERT_EQ(pool.make(S1{6})->stamp, 6);
+        ASSERT_EQ(pool.stats().hits, 5);
+        kept = second;
+    }
+    ASSERT_EQ(kept->stamp, 4); // outlives the pool
+}
+
+TEST(synchrodata, keyedData)
+{
+    KeyedSynchronizedData<int, Required<R1, R2>, Optional<O1>> data(4);
+    std::vector<int> r1_keys;
+    data.onReceived<R1>([&r1_keys](const int& key, const std::shared_ptr<R1>&) { r1_keys.push_back(key); });
+
+    for (int key = 0; key < 100; ++key)
+    {
+        data.send(key, std::make_shared<R1>());
+    }
+    ASSERT_EQ(data.size(), 100);
+    ASSERT_TRUE(r1_keys.empty());
+    data.send(42, std::make_shared<R2>()); // only key 42 is synchronized
+    ASSERT_EQ(r1_keys, std::vector<int>{42});
+    data.send(42, std::make_shared<R1>());
+    data.send(7, std::make_shared<R1>());
+    ASSERT_EQ(r1_keys, (std::vector<int>{42, 42}));
+
+    data.evict(42);
+    ASSERT_EQ(data.size(), 99);
+    data.send(42, std::make_shared<R1>()); // new state for key 42
+    ASSERT_EQ(r1_keys.size(), 2);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    data.send(7, std::make_shared<O1>());
+    ASSERT_EQ(data.evictIdle(std::chrono::milliseconds(10)), 99);
+    ASSERT_EQ(data.size(), 1);
+
+    // entries of evicted keys are reused, remaining keys keep their state
+    for (int key = 100; key < 200; ++key)
+    {
+        data.send(key, std::make_shared<R1>());
+    }
+    ASSERT_EQ(data.size(), 101);
+    data.send(7, std::make_shared<R2>());
+    data.send(150, std::make_shared<R2>());
+    ASSERT_EQ(r1_keys, (std::vector<int>{42, 42, 7, 150}));
+
+    // automatic eviction while sending
+    KeyedSynchronizedData<int, Required<R1>> timed(1, std::chrono::milliseconds(10));
+    timed.send(0, std::make_shared<R1>());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    timed.send(1, std::make_shared<R1>());
+    ASSERT_EQ(timed.size(), 1);
+
+    // callbacks are called once the shard is unlocked, and may send to the same shard
+    KeyedSynchronizedData<int, Required<R1>> chained(1);
+    std::vector<int> chained_keys;
+    chained.onReceived<R1>(
+        [&chained, &chained_keys](const int& key, const std::shared_ptr<R1>& r1)
+        {
+            chained_keys.push_back(key);
+            if (key < 3)
+            {
+                chained.send(key + 1, r1);
+            }
+        });
+    chained.onReceived<R1>([&chained_keys](const int& key, const std::shared_ptr<R1>&) { chained_keys.push_back(-key); });
+    chained.send(0, std::make_shared<R1>());
+    ASSERT_EQ(chained_keys, (std::vector<int>{0, 1, 2, 3, -3, -2, -1, 0}));
+}
+
 template<class T>
 struct Pooler : public synchro::Broadcaster<T>
 {
@@ -130,6 +1076,209 @@ TEST(Synchronizer, base)
     ASSERT_TRUE(r1_received);
 }
 
+TEST(Synchronizer, shm)
+{
+    const std::string name = "/synchro_test_" + std::to_string(::getpid());
+    ShmPooler<S1>::remove(name);
+    ShmPooler<S2>::remove(name + "_2");
+    ASSERT_THROW(ShmProducer<S1>(name, 0), std::invalid_argument);
+    ShmProducer<S1> producer(name, 2);
+    Synchronizer<ShmPooler, Required<S1, S2>> synchronizer(std::make_tuple(ShmPooler<S1>(name, 2), ShmPooler<S2>(name + "_2", 2)));
+    std::vector<std::shared_ptr<S1>> received;
+    synchronizer.data().onReceived<S1>([&received](const std::shared_ptr<S1>& data) { received.push_back(data); });
+    synchronizer.data().send(std::make_shared<S2>());
+
+    ASSERT_TRUE(producer.tryPush(S1{1}));
+    ASSERT_TRUE(producer.tryEmplace([](S1& data) { data.stamp = 2; }));
+    ASSERT_FALSE(producer.tryPush(S1{3})); // full
+    ASSERT_EQ(synchronizer.pooler<S1>().poll(), 2);
+    ASSERT_EQ(received.size(), 2);
+    ASSERT_EQ(received[0]->stamp, 1);
+    ASSERT_EQ(received[1]->stamp, 2);
+    ASSERT_FALSE(producer.tryPush(S1{3})); // slots still held
+
+    received.erase(received.begin()); // gives back first slot
+    ASSERT_TRUE(producer.tryPush(S1{3}));
+    ASSERT_FALSE(producer.tryPush(S1{4}));
+    ASSERT_EQ(synchronizer.pooler<S1>().poll(), 1);
+    ASSERT_EQ(received.back()->stamp, 3);
+    ASSERT_EQ(synchronizer.pooler<S1>().poll(), 0);
+
+    ASSERT_THROW(ShmPooler<S1>(name, 4), std::system_error); // other layout
+    ASSERT_TRUE(ShmPooler<S1>::remove(name));
+    ASSERT_TRUE(ShmPooler<S2>::remove(name + "_2"));
+}
+
+TEST(Synchronizer, reactor)
+{
+    int pipe[2];
+    ASSERT_EQ(::pipe2(pipe, O_NONBLOCK), 0);
+    const int event = ::eventfd(0, EFD_NONBLOCK);
+    ASSERT_GE(event, 0);
+    auto readPipe = [](int fd)
+    {
+        char byte = 0;
+        return ::read(fd, &byte, 1) == 1 ? std::make_shared<S1>(S1{byte}) : nullptr;
+    };
+    auto readEvent = [](int fd)
+    {
+        std::uint64_t value = 0;
+        return ::read(fd, &value, sizeof(value)) == sizeof(value) ? std::make_shared<S2>() : nullptr;
+    };
+
+    std::vector<int> stamps;
+    std::mutex mutex;
+    std::condition_variable received;
+    {
+        Reactor reactor; // single thread, both sources feed the same synchronized data
+        Synchronizer<FdPooler, Required<S1, S2>> synchronizer(std::make_tuple(FdPooler<S1>(reactor, pipe[0], readPipe), FdPooler<S2>(reactor, event, readEvent)));
+        synchronizer.data().onReceived<S1>(
+            [&](const std::shared_ptr<S1>& data)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stamps.push_back(data->stamp);
+                received.notify_all();
+            });
+
+        const char bytes[] = {1, 2};
+        ASSERT_EQ(::write(pipe[1], bytes, 2), 2);
+        const std::uint64_t one = 1;
+        ASSERT_EQ(::write(event, &one, sizeof(one)), sizeof(one)); // synchronized, last pending S1 is notified
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ASSERT_TRUE(received.wait_for(lock, std::chrono::seconds(5), [&stamps] { return !stamps.empty(); }));
+        }
+        ASSERT_EQ(::write(pipe[1], bytes, 1), 1);
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(received.wait_for(lock, std::chrono::seconds(5), [&stamps] { return stamps.size() == 2; }));
+        ASSERT_EQ(stamps, (std::vector<int>{2, 1}));
+    }
+    ::close(pipe[0]);
+    ::close(pipe[1]);
+    ::close(event);
+}
+
+TEST(Synchronizer, recordReplay)
+{
+    const std::string path = testing::TempDir() + "synchro_record_" + std::to_string(::getpid()) + ".log";
+    {
+        Synchronizer<Pooler, Required<S1, R1>, Optional<O1>> synchronizer(std::make_tuple(Pooler<S1>(), Pooler<R1>()), std::make_tuple(Pooler<O1>()));
+        Recorder<Required<S1, R1>, Optional<O1>> recorder(path);
+        auto connections                      = recorder.attach(synchronizer);
+        synchronizer.pooler<S1>().data->stamp = 7;
+        synchronizer.pooler<S1>().sendData();
+        synchronizer.pooler<O1>().sendData();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        synchronizer.pooler<R1>().sendData();
+        recorder.record(std::make_shared<L1>()); // not recorded type
+        ASSERT_EQ(connections.size(), 3);
+    }
+
+    Replayer<Required<S1, R1>, Optional<O1>> replayer(path);
+    SynchronizedData<Required<S1, R1>, Optional<O1>> data;
+    std::vector<int> stamps;
+    size_t o1_count = 0;
+    data.onReceived<S1>([&stamps](const std::shared_ptr<S1>& s1) { stamps.push_back(s1->stamp); });
+    data.onReceived<O1>([&o1_count](const std::shared_ptr<O1>&) { ++o1_count; });
+    ASSERT_EQ(replayer.replay(data), 3);
+    ASSERT_EQ(stamps, std::vector<int>{7});
+    ASSERT_EQ(o1_count, 1);
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(replayer.replay(data, Pacing::Original), 3);
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    ASSERT_EQ(stamps.size(), 2); // already synchronized, forwarded immediately
+
+    ASSERT_THROW((Replayer<Required<S1>>(path)), std::runtime_error);
+
+    // zero tail left by a recorder which did not exit cleanly is not replayed
+    std::FILE* file = std::fopen(path.c_str(), "ab");
+    const std::array<char, 64> zeros{};
+    std::fwrite(zeros.data(), 1, zeros.size(), file);
+    std::fclose(file);
+    ASSERT_EQ((Replayer<Required<S1, R1>, Optional<O1>>(path).replay(data)), 3);
+
+    // payload size not matching its type
+    file                     = std::fopen(path.c_str(), "r+b");
+    const std::uint32_t size = 1;
+    std::fseek(file, sizeof(util::RecordLog::Header) + offsetof(util::RecordLog::Record, size), SEEK_SET);
+    std::fwrite(&size, sizeof(size), 1, file);
+    std::fclose(file);
+    ASSERT_THROW((Replayer<Required<S1, R1>, Optional<O1>>(path).replay(data)), std::runtime_error);
+
+    // a file which cannot be grown keeps its mapping
+    {
+        util::AppendFile append(path, 64);
+        std::memset(append.append(8), 1, 8);
+        ASSERT_THROW(append.append(std::numeric_limits<std::size_t>::max() / 4), std::system_error);
+        ASSERT_EQ(append.size(), 8);
+        std::memset(append.append(8), 2, 8);
+        ASSERT_EQ(append.data()[0], std::byte{1});
+    }
+    ASSERT_EQ(util::ReadFile(path).size(), 16);
+    std::remove(path.c_str());
+}
+
+struct Fused
+{
+    int count = 0;
+};
+struct Detection
+{
+    int count = 0;
+};
+
+TEST(Synchronizer, pipeline)
+{
+    // pose and image fused, then detection on fused and optional O1
+    using FuseStage   = Stage<Fused, Required<R1, R2>>;
+    using DetectStage = Stage<Detection, Required<Fused>, Optional<O1>>;
+    int fused         = 0;
+    Pipeline<Pooler, Stages<FuseStage, DetectStage>> pipeline(
+        [&fused](const FuseStage::Set&) { return std::make_shared<Fused>(Fused{++fused}); },
+        [](const DetectStage::Set& set) { return set.get<O1>() ? std::make_shared<Detection>(Detection{set.get<Fused>()->count}) : nullptr; });
+    static_assert(std::is_same_v<decltype(pipeline)::Inputs, std::tuple<R1, R2, O1>>);
+
+    std::vector<int> fused_counts;
+    std::vector<int> detections;
+    pipeline.onReceived<Fused>([&fused_counts](const std::shared_ptr<Fused>& data) { fused_counts.push_back(data->count); });
+    pipeline.onReceived<Detection>([&detections](const std::shared_ptr<Detection>& data) { detections.push_back(data->count); });
+
+    pipeline.pooler<R1>().sendData();
+    ASSERT_TRUE(fused_counts.empty());
+    pipeline.pooler<R2>().sendData();
+    ASSERT_EQ(fused_counts, std::vector<int>{1});
+    ASSERT_TRUE(detections.empty()); // detection waits for O1, null output is dropped
+    pipeline.pooler<O1>().sendData();
+    pipeline.pooler<R1>().sendData();
+    ASSERT_EQ(fused_counts, (std::vector<int>{1, 2}));
+    ASSERT_EQ(detections, std::vector<int>{2});
+
+    // detection on its own executor, set while no element is processed
+    {
+        ThreadPool pool(1);
+        pipeline.runOn<1>(pool.executor());
+        pipeline.pooler<O1>().sendData();
+        pipeline.pooler<R2>().sendData();
+    } // pool runs remaining tasks
+    ASSERT_EQ(detections, (std::vector<int>{2, 3}));
+
+    // fusion on its own executor: detection, fed by the fusion and the O1 pooler, is serialized on that executor
+    {
+        ThreadPool pool(4);
+        pipeline.runOn<1>(Executor());
+        pipeline.runOn<0>(pool.executor());
+        for (int i = 0; i < 100; ++i)
+        {
+            pipeline.pooler<O1>().sendData();
+            pipeline.pooler<R1>().sendData();
+        }
+    }
+    ASSERT_EQ(fused_counts.size(), 103);
+    ASSERT_GT(detections.size(), 2);
+    ASSERT_TRUE(std::is_sorted(detections.begin(), detections.end()));
+}
+
 TEST(Synchronizer, sync)
 {
     bool r1_received = false;